@@ -0,0 +1,72 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int routeCount = 500;
+static const int threadCount = 64;
+static const int lookupsPerThread = 2000;
+
+static std::string route(int i) {
+  return "/api/v1/route" + std::to_string(i);
+}
+
+static std::string handler(int i) {
+  return "handler" + std::to_string(i);
+}
+
+TEST_CASE("A frozen document can be read by several threads") {
+  DynamicJsonDocument doc(256 * 1024);
+  JsonObject routes = doc.createNestedObject("routes");
+  for (int i = 0; i < routeCount; i++) {
+    JsonObject r = routes.createNestedObject(route(i));
+    r["handler"] = handler(i);
+    r["weight"] = i;
+    JsonArray methods = r.createNestedArray("methods");
+    methods.add("GET");
+    methods.add("POST");
+  }
+  REQUIRE(doc.overflowed() == false);
+
+  doc.freeze();
+  size_t usage = doc.memoryUsage();
+  std::string expected = doc.as<std::string>();
+
+  const JsonDocument& cdoc = doc;
+  std::atomic<int> errors(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++) {
+    threads.emplace_back([&cdoc, &errors, t] {
+      JsonObjectConst table = cdoc["routes"];
+      unsigned seed = static_cast<unsigned>(t) * 2654435761u + 1;
+      for (int j = 0; j < lookupsPerThread; j++) {
+        seed = seed * 1103515245u + 12345u;
+        int i = static_cast<int>((seed >> 8) % (routeCount + 10));
+        JsonObjectConst r = table[route(i)];
+        bool ok = i < routeCount
+                      ? r["handler"] == handler(i) && r["weight"] == i &&
+                            r["methods"][1] == "POST"
+                      : r.isNull();
+        if (!ok)
+          errors++;
+      }
+      if (t % 16 == 0 && cdoc.as<std::string>().size() == 0)
+        errors++;
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  REQUIRE(errors == 0);
+  REQUIRE(doc.memoryUsage() == usage);
+  REQUIRE(doc.as<std::string>() == expected);
+}
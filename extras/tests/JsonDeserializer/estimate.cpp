@@ -0,0 +1,98 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Checks that the estimate is the capacity that deserializeJson() uses
+static void checkExactEstimate(const std::string& input) {
+  CAPTURE(input);
+  size_t capacity = estimateJsonCapacity(input);
+
+  DynamicJsonDocument doc(capacity);
+  REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == capacity);
+}
+
+TEST_CASE("estimateJsonCapacity()") {
+  SECTION("Exact for unique strings") {
+    const char* inputs[] = {
+        "42",
+        "\"hello\"",
+        "[]",
+        "{}",
+        "  [ 1 , 2 ]  ",
+        "[1,-2.5,3e2,true,false,null]",
+        "{\"a\":1,\"b\":[{\"c\":\"d\"}],\"e\":{}}",
+        "[\"\\\"\",\"\\\\\",\"\\/\\b\\f\\n\\r\\t\"]",
+        "[\"\\u00e4\\ud83d\\udda4\",\"\\u0041\"]",
+        "{'single':'quotes',unquoted:1}",
+        "[[[[[]]]],{\"x\":[{},{}]}]",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      checkExactEstimate(inputs[i]);
+  }
+
+  SECTION("Large document") {
+    std::string json = "[";
+    for (int i = 0; i < 100; i++) {
+      char buffer[64];
+      sprintf(buffer, "{\"id%d\":%d,\"name%d\":\"sensor-%d\"},", i, i, i, i);
+      json += buffer;
+    }
+    json += "{}]";
+
+    checkExactEstimate(json);
+  }
+
+  SECTION("Counts duplicate strings twice") {
+    std::string input = "[\"hello\",\"hello\"]";
+    size_t capacity = estimateJsonCapacity(input);
+    REQUIRE(capacity == JSON_ARRAY_SIZE(2) + 2 * JSON_STRING_SIZE(5));
+
+    DynamicJsonDocument doc(capacity);
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(5));
+  }
+
+  SECTION("Strings of a char* input stay in the input") {
+    std::vector<char> input;
+    const char* json = "{\"hello\":\"world\"}";
+    input.assign(json, json + strlen(json) + 1);
+
+    REQUIRE(estimateJsonCapacity(&input[0]) == JSON_OBJECT_SIZE(1));
+    REQUIRE(std::string(&input[0]) == json);  // not modified
+  }
+
+  SECTION("const char*") {
+    REQUIRE(estimateJsonCapacity("[\"hi\"]") ==
+            JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(2));
+  }
+
+  SECTION("const char*, size_t") {
+    REQUIRE(estimateJsonCapacity("[1,2][3]", 5) == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("Returns 0 for an invalid input") {
+    REQUIRE(estimateJsonCapacity("[1,2") == 0);
+    REQUIRE(estimateJsonCapacity("{\"a\" 1}") == 0);
+    REQUIRE(estimateJsonCapacity("[\"hello]") == 0);
+    REQUIRE(estimateJsonCapacity("") == 0);
+    REQUIRE(estimateJsonCapacity("[,]") == 0);
+    REQUIRE(estimateJsonCapacity("[1,,2]") == 0);
+    REQUIRE(estimateJsonCapacity("{\"a\":}") == 0);
+    REQUIRE(estimateJsonCapacity("[-]") == 0);
+    REQUIRE(estimateJsonCapacity("[tru]") == 0);
+  }
+
+  SECTION("Honors the nesting limit") {
+    REQUIRE(estimateJsonCapacity("[[]]", DeserializationOption::NestingLimit(
+                                             1)) == 0);
+    REQUIRE(estimateJsonCapacity("[[]]", DeserializationOption::NestingLimit(
+                                             2)) == JSON_ARRAY_SIZE(1));
+  }
+}
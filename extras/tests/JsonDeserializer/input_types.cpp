@@ -22,6 +22,25 @@ TEST_CASE("deserializeJson(char*)") {
     CHECK(doc.as<JsonVariant>().memoryUsage() ==
           JSON_OBJECT_SIZE(1));  // issue #1318
   }
+
+  SECTION("should find the terminator wherever it is") {
+    DynamicJsonDocument big(4096);
+    std::string value(1000, 'a');
+
+    for (size_t i = 0; i < 300; i++) {
+      std::string json = std::string(i, ' ') + "[\"" + value + "\"," +
+                         std::string(i, ' ') + "-123456789]";
+      CAPTURE(i);
+
+      REQUIRE(deserializeJson(big, json.c_str()) == DeserializationError::Ok);
+      REQUIRE(big[0] == value);
+      REQUIRE(big[1] == -123456789);
+
+      json.resize(json.size() - 1);
+      REQUIRE(deserializeJson(big, json.c_str()) ==
+              DeserializationError::IncompleteInput);
+    }
+  }
 }
 
 TEST_CASE("deserializeJson(const std::string&)") {
@@ -51,6 +70,20 @@ TEST_CASE("deserializeJson(const std::string&)") {
     REQUIRE(err == DeserializationError::Ok);
     REQUIRE(std::string("hello") == array[0]);
   }
+
+  SECTION("should stop at null character") {
+    DeserializationError err = deserializeJson(doc, std::string("12\0 3", 5));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 12);
+  }
+
+  SECTION("should detect unterminated string") {
+    DeserializationError err =
+        deserializeJson(doc, std::string("[\"hello\0\"]", 10));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
 }
 
 TEST_CASE("deserializeJson(std::istream&)") {
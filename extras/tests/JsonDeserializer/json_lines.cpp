@@ -0,0 +1,209 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static const char* input =
+    "{\"id\":1,\"msg\":\"hello\"}\n"
+    "\n"
+    "  [1,2]  \r\n"
+    "\"three\"\n"
+    "4";
+
+static void checkLines(JsonLinesReader& lines, JsonDocument& doc) {
+  REQUIRE(lines.next(doc) == DeserializationError::Ok);
+  REQUIRE(lines.lineNumber() == 1);
+  REQUIRE(doc["id"] == 1);
+  REQUIRE(doc["msg"] == "hello");
+
+  REQUIRE(lines.next(doc) == DeserializationError::Ok);
+  REQUIRE(lines.lineNumber() == 3);  // the blank line is skipped
+  REQUIRE(doc.size() == 2);
+  REQUIRE(doc[1] == 2);
+
+  REQUIRE(lines.next(doc) == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "three");
+
+  REQUIRE(lines.next(doc) == DeserializationError::Ok);
+  REQUIRE(lines.lineNumber() == 5);
+  REQUIRE(doc.as<int>() == 4);
+
+  REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+  REQUIRE(doc.isNull());
+  REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+}
+
+TEST_CASE("JsonLinesReader") {
+  DynamicJsonDocument doc(4096);
+  char buffer[64];
+
+  SECTION("const char* buffer") {
+    JsonLinesReader lines(input, strlen(input));
+    checkLines(lines, doc);
+  }
+
+  SECTION("char* buffer (zero-copy)") {
+    std::string copy(input);
+    JsonLinesReader lines(&copy[0], copy.size());
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(doc["msg"] == "hello");
+    REQUIRE(doc["msg"].as<const char*>() >= copy.data());
+    REQUIRE(doc["msg"].as<const char*>() < copy.data() + copy.size());
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2));
+  }
+
+  SECTION("Stops at the terminator") {
+    JsonLinesReader lines("1\n2\0\n3", 6);
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 2);
+    REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream stream(input);
+    JsonLinesReader lines(stream, buffer, sizeof(buffer));
+    checkLines(lines, doc);
+  }
+
+  SECTION("std::istream with prefetch") {
+    std::istringstream stream(input);
+    JsonLinesReader lines(stream, buffer, 23, true);  // the longest line
+    checkLines(lines, doc);
+  }
+
+  SECTION("Doesn't read the stream beyond the newline") {
+    std::istringstream stream("{\"a\":1}\n[2]\nrest");
+    JsonLinesReader lines(stream, buffer, sizeof(buffer));
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(stream.tellg() == 8);
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(stream.tellg() == 12);
+  }
+
+  SECTION("Resumes after an invalid line") {
+    std::istringstream stream("{\"a\":1}\n{\"a\":}\n[\n{\"a\":3}\n");
+    JsonLinesReader lines(stream, buffer, sizeof(buffer));
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(lines.next(doc) == DeserializationError::InvalidInput);
+    REQUIRE(lines.lineNumber() == 2);
+    REQUIRE(lines.next(doc) == DeserializationError::IncompleteInput);
+    REQUIRE(lines.lineNumber() == 3);
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 3);
+    REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("Line longer than the buffer") {
+    const char* json = "[1]\n[\"0123456789\"]\n[3]";
+
+    SECTION("without prefetch") {
+      std::istringstream stream(json);
+      JsonLinesReader lines(stream, buffer, 8);
+
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(lines.next(doc) == DeserializationError::NoMemory);
+      REQUIRE(lines.lineNumber() == 2);
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(doc[0] == 3);
+      REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+    }
+
+    SECTION("with prefetch") {
+      std::istringstream stream(json);
+      JsonLinesReader lines(stream, buffer, 8, true);
+
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(lines.next(doc) == DeserializationError::NoMemory);
+      REQUIRE(lines.lineNumber() == 2);
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(doc[0] == 3);
+      REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+    }
+
+    SECTION("line as long as the buffer") {
+      std::istringstream stream("[\"0123\"]\n[\"01234\"]\n[\"0123\"]");
+      JsonLinesReader lines(stream, buffer, 8, true);
+
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(lines.next(doc) == DeserializationError::NoMemory);
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+    }
+
+    SECTION("last line with prefetch") {
+      std::istringstream stream("[1]\n[\"0123456789\"]");
+      JsonLinesReader lines(stream, buffer, 8, true);
+
+      REQUIRE(lines.next(doc) == DeserializationError::Ok);
+      REQUIRE(lines.next(doc) == DeserializationError::NoMemory);
+      REQUIRE(lines.next(doc) == DeserializationError::EmptyInput);
+    }
+  }
+
+  SECTION("Nesting limit") {
+    JsonLinesReader lines("[[1]]\n[2]", 9);
+
+    REQUIRE(lines.next(doc, DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+    REQUIRE(lines.next(doc, DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::Ok);
+  }
+
+  SECTION("nextBatch()") {
+    std::istringstream stream(input);
+    JsonLinesReader lines(stream, buffer, sizeof(buffer));
+
+    REQUIRE(lines.nextBatch(doc, 3) == DeserializationError::Ok);
+    REQUIRE(doc.size() == 3);
+    REQUIRE(doc[0]["msg"] == "hello");
+    REQUIRE(doc[1][0] == 1);
+    REQUIRE(doc[2] == "three");
+
+    REQUIRE(lines.nextBatch(doc, 3) == DeserializationError::Ok);
+    REQUIRE(doc.size() == 1);
+    REQUIRE(doc[0] == 4);
+
+    REQUIRE(lines.nextBatch(doc, 3) == DeserializationError::EmptyInput);
+    REQUIRE(doc.size() == 0);
+  }
+
+  SECTION("nextBatch() stops at the first error") {
+    JsonLinesReader lines("1\n2\n{\n4\n", 8);
+
+    REQUIRE(lines.nextBatch(doc, 10) == DeserializationError::IncompleteInput);
+    REQUIRE(lines.lineNumber() == 3);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc[1] == 2);
+
+    REQUIRE(lines.nextBatch(doc, 10) == DeserializationError::Ok);
+    REQUIRE(doc.size() == 1);
+    REQUIRE(doc[0] == 4);
+  }
+
+  SECTION("nextBatch() in a StaticJsonDocument") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> small;
+    JsonLinesReader lines("1\n2\n3", 5);
+
+    REQUIRE(lines.nextBatch(small, 2) == DeserializationError::Ok);
+    REQUIRE(small.size() == 2);
+    REQUIRE(lines.nextBatch(small, 2) == DeserializationError::Ok);
+    REQUIRE(small[0] == 3);
+  }
+
+  SECTION("nextBatch() returns NoMemory when the array is full") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> small;
+    JsonLinesReader lines("1\n2", 3);
+
+    REQUIRE(lines.nextBatch(small, 2) == DeserializationError::NoMemory);
+    REQUIRE(small.size() == 1);
+  }
+}
@@ -36,6 +36,26 @@ TEST_CASE("deserializeJson(DynamicJsonDocument&)") {
       REQUIRE(err == DeserializationError::EmptyInput);
     }
 
+    SECTION("Long runs of spaces") {
+      // cross the 8 and 16-byte boundaries of the bulk scanner
+      for (size_t i = 0; i < 40; i++) {
+        std::string spaces;
+        for (size_t j = 0; j < i; j++) spaces += " \t\r\n"[j % 4];
+        std::string input = spaces + "[" + spaces + "1" + spaces + "," +
+                            spaces + "2" + spaces + "]" + spaces;
+        CAPTURE(i);
+
+        DeserializationError err = deserializeJson(doc, input);
+
+        REQUIRE(err == DeserializationError::Ok);
+        REQUIRE(doc.size() == 2);
+
+        err = deserializeJson(doc, spaces);
+
+        REQUIRE(err == DeserializationError::EmptyInput);
+      }
+    }
+
     SECTION("issue #628") {
       DeserializationError err = deserializeJson(doc, "null");
       REQUIRE(err == DeserializationError::Ok);
@@ -92,6 +92,19 @@ TEST_CASE("deserialize an integer") {
 #endif
   }
 
+  SECTION("Integers in arrays") {
+    DeserializationError err =
+        deserializeJson(doc, "[123456789,-12345678,12345678.5,1e8]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == 123456789);
+    REQUIRE(doc[1] == -12345678);
+    REQUIRE(doc[2].is<float>());
+    REQUIRE(doc[2].as<double>() == Approx(12345678.5));
+    REQUIRE(doc[3].is<float>());
+    REQUIRE(doc[3].as<double>() == Approx(1e8));
+  }
+
   SECTION("Floats") {
     SECTION("Double") {
       DeserializationError err = deserializeJson(doc, "-1.23e+4");
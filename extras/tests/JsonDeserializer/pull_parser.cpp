@@ -0,0 +1,161 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+typedef JsonPullParser<const char*> Parser;
+
+// Writes the events in a compact form, like "{ k:a n:1 }"
+template <typename TParser>
+static std::string events(TParser& parser) {
+  std::ostringstream out;
+  for (;;) {
+    switch (parser.next()) {
+      case TParser::StartObject:
+        out << "{ ";
+        break;
+      case TParser::EndObject:
+        out << "} ";
+        break;
+      case TParser::StartArray:
+        out << "[ ";
+        break;
+      case TParser::EndArray:
+        out << "] ";
+        break;
+      case TParser::Key:
+        out << "k:" << parser.value().template as<std::string>() << " ";
+        break;
+      case TParser::StringValue:
+        out << "s:" << parser.value().template as<std::string>() << " ";
+        break;
+      case TParser::NumberValue:
+        out << "n:" << parser.value().template as<double>() << " ";
+        break;
+      case TParser::BooleanValue:
+        out << "b:" << parser.value().template as<bool>() << " ";
+        break;
+      case TParser::NullValue:
+        out << "null ";
+        break;
+      case TParser::EndOfDocument:
+        return out.str();
+      case TParser::Error:
+        out << "error:" << parser.error().c_str();
+        return out.str();
+    }
+  }
+}
+
+static std::string events(const char* input) {
+  Parser parser(input);
+  return events(parser);
+}
+
+TEST_CASE("JsonPullParser") {
+  SECTION("Object") {
+    REQUIRE(events("{\"a\":1,\"b\":\"x\",\"c\":true,\"d\":null}") ==
+            "{ k:a n:1 k:b s:x k:c b:1 k:d null } ");
+  }
+
+  SECTION("Nested collections") {
+    REQUIRE(events(" [ { \"a\" : [ ] } , [ 1.5 , -2 ] , { } ] ") ==
+            "[ { k:a [ ] } [ n:1.5 n:-2 ] { } ] ");
+  }
+
+  SECTION("Scalars") {
+    REQUIRE(events("42") == "n:42 ");
+    REQUIRE(events("\"hello\"") == "s:hello ");
+    REQUIRE(events("false") == "b:0 ");
+    REQUIRE(events("null") == "null ");
+  }
+
+  SECTION("Same syntax as deserializeJson()") {
+    REQUIRE(events("{a:'b\\n',\"c\":1e3}") ==
+            "{ k:a s:b\n k:c n:1000 } ");
+  }
+
+  SECTION("Stops after the first value") {
+    std::istringstream stream("[1] [2]");
+    JsonPullParser<std::istream> parser(stream);
+
+    REQUIRE(events(parser) == "[ n:1 ] ");
+    REQUIRE(parser.next() == JsonPullParser<std::istream>::EndOfDocument);
+    REQUIRE(stream.tellg() == 3);
+  }
+
+  SECTION("Errors") {
+    REQUIRE(events("") == "error:EmptyInput");
+    REQUIRE(events("[1,") == "[ n:1 error:IncompleteInput");
+    REQUIRE(events("[1}") == "[ n:1 error:InvalidInput");
+    REQUIRE(events("{\"a\" 1}") == "{ error:InvalidInput");
+    REQUIRE(events("{\"a\":1]") == "{ k:a n:1 error:InvalidInput");
+    REQUIRE(events("[\"abc") == "[ error:IncompleteInput");
+    REQUIRE(events("[1x]") == "[ error:InvalidInput");
+  }
+
+  SECTION("Returns the same event after the end") {
+    Parser parser("1");
+
+    REQUIRE(parser.next() == Parser::NumberValue);
+    REQUIRE(parser.next() == Parser::EndOfDocument);
+    REQUIRE(parser.next() == Parser::EndOfDocument);
+
+    Parser invalid("]");
+    REQUIRE(invalid.next() == Parser::Error);
+    REQUIRE(invalid.next() == Parser::Error);
+    REQUIRE(invalid.error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("Nesting limit") {
+    Parser ok("[[1]]", DeserializationOption::NestingLimit(2));
+    REQUIRE(events(ok) == "[ [ n:1 ] ] ");
+
+    Parser tooDeep("[[1]]", DeserializationOption::NestingLimit(1));
+    REQUIRE(events(tooDeep) == "[ error:TooDeep");
+  }
+
+  SECTION("depth()") {
+    Parser parser("{\"a\":[1]}");
+
+    REQUIRE(parser.depth() == 0);
+    REQUIRE(parser.next() == Parser::StartObject);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == Parser::Key);
+    REQUIRE(parser.next() == Parser::StartArray);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == Parser::NumberValue);
+    REQUIRE(parser.next() == Parser::EndArray);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == Parser::EndObject);
+    REQUIRE(parser.depth() == 0);
+  }
+
+  SECTION("Strings longer than the buffer") {
+    JsonPullParser<const char*, 7> parser("[\"abcdefg\",\"abcdefgh\"]");
+
+    REQUIRE(events(parser) == "[ s:abcdefg error:NoMemory");
+  }
+
+  SECTION("Large input in constant memory") {
+    std::string json = "[";
+    for (int i = 0; i < 10000; i++)
+      json += "{\"id\":1,\"tags\":[\"a\",\"b\"]},";
+    json[json.size() - 1] = ']';
+
+    typedef JsonPullParser<std::string> StringParser;
+    StringParser parser(json);
+    long sum = 0;
+    StringParser::Event event;
+    while ((event = parser.next()) != StringParser::EndOfDocument) {
+      REQUIRE(event != StringParser::Error);
+      if (event == StringParser::NumberValue)
+        sum += parser.value().as<long>();
+    }
+    REQUIRE(sum == 10000);
+  }
+}
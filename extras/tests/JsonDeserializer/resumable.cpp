@@ -0,0 +1,181 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+typedef ResumableJsonDeserializer<> Parser;
+
+// Feeds the input in chunks of the specified size
+static DeserializationError feedInChunks(JsonDocument& doc,
+                                         const std::string& input,
+                                         size_t chunkSize) {
+  Parser parser(doc);
+  DeserializationError err = DeserializationError::IncompleteInput;
+  for (size_t i = 0; i < input.size(); i += chunkSize) {
+    size_t n = input.size() - i < chunkSize ? input.size() - i : chunkSize;
+    err = parser.feed(input.data() + i, n);
+    if (err != DeserializationError::IncompleteInput)
+      break;
+  }
+  return parser.finish();
+}
+
+TEST_CASE("ResumableJsonDeserializer") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("Same result as deserializeJson(), whatever the chunk size") {
+    const char* inputs[] = {
+        "[]",
+        "{}",
+        "  [ 1 , 2 ]  ",
+        "[1,-2.5,3e2,true,false,null]",
+        "{\"a\":1,\"b\":[{\"c\":\"d\"}],\"e\":{}}",
+        "{\"a\":1,\"a\":[2]}",
+        "{\"a\":[1],\"a\":{\"b\":2}}",
+        "[\"\\\"\",\"\\\\\",\"\\/\\b\\f\\n\\r\\t\"]",
+        "[\"\\u00e4\\ud83d\\udda4\"]",
+        "{key:'value',\"k2\":[[],[[]],{}]}",
+        "\"hello world\"",
+        "true",
+        "-123.456",
+        "[\"a very long string that gets cut several times\"]",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      DynamicJsonDocument expected(4096);
+      REQUIRE(deserializeJson(expected, inputs[i]) ==
+              DeserializationError::Ok);
+
+      for (size_t chunkSize = 1; chunkSize <= 8; chunkSize++) {
+        CAPTURE(inputs[i]);
+        CAPTURE(chunkSize);
+        REQUIRE(feedInChunks(doc, inputs[i], chunkSize) ==
+                DeserializationError::Ok);
+        REQUIRE(doc == expected);
+      }
+    }
+  }
+
+  SECTION("Returns IncompleteInput until the end") {
+    Parser parser(doc);
+
+    REQUIRE(parser.feed("{\"na", 4) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("me\":\"Jo", 7) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(doc.as<JsonObject>().size() == 1);  // the key is here already
+    REQUIRE(parser.feed("hn\",\"age\":4", 11) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("2}", 2) == DeserializationError::Ok);
+    REQUIRE(doc["name"] == "John");
+    REQUIRE(doc["age"] == 42);
+
+    // the rest is ignored
+    REQUIRE(parser.feed("[1]", 3) == DeserializationError::Ok);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc.size() == 2);
+  }
+
+  SECTION("finish() completes a number") {
+    Parser parser(doc);
+
+    REQUIRE(parser.feed("4", 1) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("2", 1) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 42);
+  }
+
+  SECTION("finish() reports the missing parts") {
+    Parser parser(doc);
+    REQUIRE(parser.feed("[1,", 3) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::IncompleteInput);
+
+    Parser empty(doc);
+    REQUIRE(empty.feed("  ", 2) == DeserializationError::IncompleteInput);
+    REQUIRE(empty.finish() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("Stops at the terminator") {
+    Parser parser(doc);
+    REQUIRE(parser.feed("12\0003", 4) == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 12);
+  }
+
+  SECTION("The terminator ends an incomplete input") {
+    Parser parser(doc);
+    REQUIRE(parser.feed("[1,", 3) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("\0", 1) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("2]", 2) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::IncompleteInput);
+    REQUIRE(doc.size() == 1);
+  }
+
+  SECTION("Nothing is parsed after finish()") {
+    Parser parser(doc);
+    REQUIRE(parser.feed("[1,", 3) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("2]", 2) == DeserializationError::IncompleteInput);
+    REQUIRE(doc.size() == 1);
+  }
+
+  SECTION("Invalid input") {
+    const char* inputs[] = {
+        "[1,]", "[1}", "{\"a\" 1}", "{\"a\":1]", "[1x]", "[tru]", "]", "{,}",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      CAPTURE(inputs[i]);
+      REQUIRE(feedInChunks(doc, inputs[i], 1) ==
+              DeserializationError::InvalidInput);
+    }
+  }
+
+  SECTION("The error is final") {
+    Parser parser(doc);
+
+    REQUIRE(parser.feed("[}", 2) == DeserializationError::InvalidInput);
+    REQUIRE(parser.feed("]", 1) == DeserializationError::InvalidInput);
+    REQUIRE(parser.finish() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("Nesting limit") {
+    ResumableJsonDeserializer<2> parser(doc);
+    REQUIRE(parser.feed("[[1]]", 5) == DeserializationError::Ok);
+
+    ResumableJsonDeserializer<2> tooDeep(doc);
+    REQUIRE(tooDeep.feed("[[[1]]]", 7) == DeserializationError::TooDeep);
+  }
+
+  SECTION("Token cut by a chunk") {
+    ResumableJsonDeserializer<10, 8> parser(doc);
+
+    SECTION("longer than maxTokenLength") {
+      REQUIRE(parser.feed("[\"abcd", 6) ==
+              DeserializationError::IncompleteInput);
+      REQUIRE(parser.feed("efgh\"]", 6) == DeserializationError::NoMemory);
+    }
+
+    SECTION("long token in one chunk") {
+      REQUIRE(parser.feed("[\"abcdefghijklmnop\",\"a", 22) ==
+              DeserializationError::IncompleteInput);
+      REQUIRE(parser.feed("b\"]", 3) == DeserializationError::Ok);
+      REQUIRE(doc[0] == "abcdefghijklmnop");
+      REQUIRE(doc[1] == "ab");
+    }
+
+    SECTION("escape sequence cut by a chunk") {
+      REQUIRE(parser.feed("[\"a\\", 4) ==
+              DeserializationError::IncompleteInput);
+      REQUIRE(parser.feed("\"b\"]", 4) == DeserializationError::Ok);
+      REQUIRE(doc[0] == "a\"b");
+    }
+  }
+
+  SECTION("NoMemory") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> small;
+    Parser parser(small);
+
+    REQUIRE(parser.feed("[1,", 3) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("2]", 2) == DeserializationError::NoMemory);
+  }
+}
@@ -5,6 +5,7 @@
 #define ARDUINOJSON_DECODE_UNICODE 1
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <vector>
 
 TEST_CASE("Valid JSON strings value") {
   struct TestCase {
@@ -46,6 +47,62 @@ TEST_CASE("Valid JSON strings value") {
   }
 }
 
+static void checkLongString(const std::string& input,
+                            const std::string& expected) {
+  DynamicJsonDocument doc(4096);
+  CAPTURE(input);
+
+  DeserializationError err = deserializeJson(doc, input.c_str());
+  CHECK(err == DeserializationError::Ok);
+  CHECK(doc[0] == expected);
+
+  // char* input => the strings are moved in place
+  std::vector<char> buffer(input.begin(), input.end());
+  buffer.push_back(0);
+  err = deserializeJson(doc, &buffer[0]);
+  CHECK(err == DeserializationError::Ok);
+  CHECK(doc[0] == expected);
+}
+
+TEST_CASE("Long JSON strings") {
+  // put a special character at every position around the 16 and 32-byte
+  // boundaries of the bulk scanner
+  const std::string text(70, 'a');
+
+  SECTION("escape sequence") {
+    for (size_t i = 0; i < text.size(); i++) {
+      std::string expected = text;
+      expected[i] = '\n';
+      checkLongString("[\"" + text.substr(0, i) + "\\n" + text.substr(i + 1) +
+                          "\",\"" + text + "\"]",
+                      expected);
+    }
+  }
+
+  SECTION("closing quote") {
+    for (size_t i = 0; i < text.size(); i++) {
+      std::string expected = text.substr(0, i);
+      checkLongString("[\"" + expected + "\",\"" + text + "\"]", expected);
+    }
+  }
+
+  SECTION("control character") {
+    for (size_t i = 0; i < text.size(); i++) {
+      std::string expected = text;
+      expected[i] = '\t';
+      checkLongString("[\"" + expected + "\",\"" + text + "\"]", expected);
+    }
+  }
+
+  SECTION("other quote") {
+    for (size_t i = 0; i < text.size(); i++) {
+      std::string expected = text;
+      expected[i] = '\'';
+      checkLongString("[\"" + expected + "\",\"" + text + "\"]", expected);
+    }
+  }
+}
+
 TEST_CASE("\\u0000") {
   StaticJsonDocument<200> doc;
 
@@ -0,0 +1,200 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+
+static void reparse(JsonDocument& doc, const char* json) {
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+}
+
+TEST_CASE("JsonDocument::compact()") {
+  DynamicJsonDocument doc(4096);
+  DynamicJsonDocument expected(4096);
+
+  SECTION("empty document") {
+    doc.compact();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("removed members") {
+    reparse(doc, "{\"blanket\":1,\"dancing\":2,\"crazy\":[3,\"four\"]}");
+    doc.remove("blanket");
+    doc.remove("crazy");
+    reparse(expected, "{\"dancing\":2}");
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "{\"dancing\":2}");
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("removed elements") {
+    reparse(doc, "[\"a\",[1,2,3],\"b\",{\"c\":\"d\"},\"e\"]");
+    doc.remove(3);
+    doc.remove(1);
+    reparse(expected, "[\"a\",\"b\",\"e\"]");
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "[\"a\",\"b\",\"e\"]");
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("replaced strings") {
+    reparse(doc, "{\"status\":\"starting\"}");
+    doc["status"] = std::string("running");
+    doc["status"] = std::string("stopping");
+    reparse(expected, "{\"status\":\"stopping\"}");
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "{\"status\":\"stopping\"}");
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("replaced root") {
+    reparse(doc, "[1,2,3]");
+    doc.set(std::string("hello"));
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "hello");
+    REQUIRE(doc.memoryUsage() == 6);
+  }
+
+  SECTION("nested collections") {
+    reparse(doc,
+            "{\"a\":{\"b\":[1,{\"c\":\"d\"},[\"e\"]],\"f\":\"g\"},"
+            "\"h\":[[[\"i\"]]],\"j\":{}}");
+    doc["a"]["b"].remove(0);
+    doc["h"][0].add(std::string("k"));
+    doc.remove("j");
+    doc["a"].remove("f");
+    const char* json =
+        "{\"a\":{\"b\":[{\"c\":\"d\"},[\"e\"]]},\"h\":[[[\"i\"],\"k\"]]}";
+    reparse(expected, json);
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == json);
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("shared strings") {
+    reparse(doc, "[{\"id\":\"x\"},{\"id\":\"y\"},{\"id\":\"x\"}]");
+    doc.remove(1);
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "[{\"id\":\"x\"},{\"id\":\"x\"}]");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 2 * JSON_OBJECT_SIZE(1) +
+                                     JSON_STRING_SIZE(2) + JSON_STRING_SIZE(1));
+  }
+
+  SECTION("the space can be used again") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(4) + 32> small;
+    for (int i = 0; i < 100; i++) {
+      char value[16];
+      sprintf(value, "value%d", i);
+      small.add(std::string(value));
+      if (small.size() > 3)
+        small.remove(0);
+      small.compact();
+      REQUIRE_FALSE(small.overflowed());
+    }
+
+    REQUIRE(small.as<std::string>() ==
+            "[\"value97\",\"value98\",\"value99\"]");
+  }
+
+  SECTION("full pool") {
+    DynamicJsonDocument full(JSON_ARRAY_SIZE(3) + 16);
+    full.add(std::string("hello"));
+    full.add(std::string("world"));
+    full.add(3);
+    full.remove(0);
+    REQUIRE(full.memoryUsage() == JSON_ARRAY_SIZE(3) + 12);
+
+    full.compact();
+
+    REQUIRE(full.as<std::string>() == "[\"world\",3]");
+    REQUIRE(full.memoryUsage() == JSON_ARRAY_SIZE(2) + 6);
+  }
+
+  SECTION("many operations") {
+    for (int i = 0; i < 500; i++) {
+      char key[16];
+      sprintf(key, "key%d", i % 37);
+      doc[std::string(key)] = std::string(key) + "!";
+      doc[std::string(key) + "_list"].add(i);
+      if (i % 3 == 0) {
+        sprintf(key, "key%d", (i * 7) % 37);
+        doc.remove(std::string(key));
+        doc.remove(std::string(key) + "_list");
+      }
+      if (i % 50 == 0) {
+        std::string json = doc.as<std::string>();
+        doc.compact();
+        REQUIRE(doc.as<std::string>() == json);
+      }
+    }
+    std::string json = doc.as<std::string>();
+    reparse(expected, json.c_str());
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == json);
+    REQUIRE(doc.memoryUsage() <= expected.memoryUsage());  // tables may differ
+    REQUIRE(doc["key36"] == expected["key36"]);
+  }
+}
+
+#if !ARDUINOJSON_COMPACT_SLOTS
+TEST_CASE("JsonDocument::compact() with pointers outside of the pool") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("linked strings") {
+    doc["hello"] = "world";
+    doc[std::string("owned")] = std::string("value");
+    doc.remove("owned");
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\"}");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("shallow copy of another document") {
+    DynamicJsonDocument other(256);
+    deserializeJson(other, "[1,\"two\",{\"three\":3}]");
+    doc.add(std::string("removed"));
+    doc.add().shallowCopy(other);
+    doc.remove(0);
+    std::string json = other.as<std::string>();
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() == "[[1,\"two\",{\"three\":3}]]");
+    REQUIRE(other.as<std::string>() == json);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("shallow copy in the same document") {
+    deserializeJson(doc, "{\"a\":[\"x\",{\"y\":\"z\"}],\"removed\":\"yes\"}");
+    doc["b"].shallowCopy(doc["a"]);
+    doc.remove("removed");
+
+    doc.compact();
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":[\"x\",{\"y\":\"z\"}],\"b\":[\"x\",{\"y\":\"z\"}]}");
+  }
+}
+#endif
@@ -0,0 +1,72 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("JsonDocument::freeze()") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("a document is writable by default") {
+    REQUIRE(doc.isFrozen() == false);
+  }
+
+  SECTION("doesn't change the content") {
+    deserializeJson(doc,
+                    "{\"routes\":[{\"path\":\"/\",\"handler\":\"index\"}]}");
+    size_t usage = doc.memoryUsage();
+
+    doc.freeze();
+
+    REQUIRE(doc.isFrozen() == true);
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(doc["routes"][0]["handler"] == "index");
+    REQUIRE(doc.as<std::string>() ==
+            "{\"routes\":[{\"path\":\"/\",\"handler\":\"index\"}]}");
+  }
+
+  SECTION("the const references can read a frozen document") {
+    deserializeJson(doc, "{\"a\":[1,2],\"b\":{\"c\":3}}");
+    doc.freeze();
+    const JsonDocument& cdoc = doc;
+    JsonObjectConst obj = cdoc.as<JsonObjectConst>();
+
+    REQUIRE(obj["a"][1] == 2);
+    REQUIRE(obj["b"]["c"] == 3);
+    REQUIRE(obj["d"].isNull());
+    REQUIRE(obj.size() == 2);
+  }
+
+  SECTION("clear() makes the document writable again") {
+    doc["hello"] = "world";
+    doc.freeze();
+
+    doc.clear();
+
+    REQUIRE(doc.isFrozen() == false);
+    doc["hello"] = "again";
+    REQUIRE(doc["hello"] == "again");
+  }
+
+  SECTION("deserializeJson() makes the document writable again") {
+    doc.freeze();
+
+    deserializeJson(doc, "[1]");
+
+    REQUIRE(doc.isFrozen() == false);
+    REQUIRE(doc[0] == 1);
+  }
+
+  SECTION("a copy is writable") {
+    doc["hello"] = "world";
+    doc.freeze();
+
+    DynamicJsonDocument copy(doc);
+
+    REQUIRE(copy.isFrozen() == false);
+    REQUIRE(copy["hello"] == "world");
+  }
+}
@@ -0,0 +1,201 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static const char* input =
+    "{\"name\":\"config\",\"values\":[1,2.5,true,null,\"three\"],"
+    "\"nested\":{\"a\":{\"b\":[[],{}]}},\"raw\":[1,2]}";
+
+TEST_CASE("saveSnapshot() / loadSnapshot()") {
+  DynamicJsonDocument src(1024);
+  deserializeJson(src, input);
+  std::string expected;
+  serializeJson(src, expected);
+
+  SECTION("round trip through a std::string") {
+    std::string snapshot;
+    size_t n = saveSnapshot(src, snapshot);
+
+    REQUIRE(n == snapshot.size());
+    REQUIRE(n == measureSnapshot(src));
+
+    DynamicJsonDocument dst(1024);
+    DeserializationError err = loadSnapshot(dst, snapshot);
+
+    REQUIRE(err == DeserializationError::Ok);
+    std::string output;
+    serializeJson(dst, output);
+    REQUIRE(output == expected);
+    REQUIRE(dst.memoryUsage() == src.memoryUsage());
+  }
+
+  SECTION("round trip through a stream") {
+    std::stringstream stream;
+    saveSnapshot(src, stream);
+
+    DynamicJsonDocument dst(1024);
+    DeserializationError err = loadSnapshot(dst, stream);
+
+    REQUIRE(err == DeserializationError::Ok);
+    std::string output;
+    serializeJson(dst, output);
+    REQUIRE(output == expected);
+  }
+
+  SECTION("round trip through a buffer") {
+    char buffer[1024];
+    size_t n = saveSnapshot(src, buffer, sizeof(buffer));
+
+    REQUIRE(n == measureSnapshot(src));
+
+    StaticJsonDocument<1024> dst;
+    DeserializationError err = loadSnapshot(dst, buffer, n);
+
+    REQUIRE(err == DeserializationError::Ok);
+    std::string output;
+    serializeJson(dst, output);
+    REQUIRE(output == expected);
+  }
+
+  SECTION("the loaded document can be modified") {
+    std::string snapshot;
+    saveSnapshot(src, snapshot);
+    DynamicJsonDocument dst(1024);
+    loadSnapshot(dst, snapshot);
+
+    dst["values"].add("four");
+    dst["name"] = std::string("modified");
+    dst.remove("nested");
+
+    REQUIRE(dst.as<std::string>() ==
+            "{\"name\":\"modified\",\"values\":[1,2.5,true,null,\"three\","
+            "\"four\"],\"raw\":[1,2]}");
+  }
+
+  SECTION("the source can be destroyed") {
+    std::string snapshot;
+    {
+      DynamicJsonDocument tmp(256);
+      deserializeJson(tmp, "[\"hello\",{\"world\":42}]");
+      saveSnapshot(tmp, snapshot);
+    }
+    DynamicJsonDocument dst(256);
+
+    REQUIRE(loadSnapshot(dst, snapshot) == DeserializationError::Ok);
+    REQUIRE(dst.as<std::string>() == "[\"hello\",{\"world\":42}]");
+  }
+
+  SECTION("empty document") {
+    DynamicJsonDocument empty(64);
+    std::string snapshot;
+    saveSnapshot(empty, snapshot);
+    DynamicJsonDocument dst(64);
+    dst.set(42);
+
+    REQUIRE(loadSnapshot(dst, snapshot) == DeserializationError::Ok);
+    REQUIRE(dst.isNull());
+  }
+
+  SECTION("EmptyInput") {
+    DynamicJsonDocument dst(1024);
+
+    REQUIRE(loadSnapshot(dst, std::string()) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("IncompleteInput") {
+    std::string snapshot;
+    saveSnapshot(src, snapshot);
+    DynamicJsonDocument dst(1024);
+
+    REQUIRE(loadSnapshot(dst, snapshot.substr(0, 10)) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(loadSnapshot(dst, snapshot.substr(0, snapshot.size() - 1)) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(dst.isNull());
+    REQUIRE(dst.memoryUsage() == 0);
+  }
+
+  SECTION("InvalidInput") {
+    std::string snapshot;
+    saveSnapshot(src, snapshot);
+    snapshot[0] = 'X';
+    DynamicJsonDocument dst(1024);
+
+    REQUIRE(loadSnapshot(dst, snapshot) == DeserializationError::InvalidInput);
+    REQUIRE(loadSnapshot(dst, expected) == DeserializationError::InvalidInput);
+  }
+
+  SECTION("NoMemory") {
+    std::string snapshot;
+    saveSnapshot(src, snapshot);
+    DynamicJsonDocument dst(src.memoryUsage() - sizeof(void*));
+
+    REQUIRE(loadSnapshot(dst, snapshot) == DeserializationError::NoMemory);
+    REQUIRE(dst.isNull());
+  }
+
+  SECTION("exact capacity") {
+    std::string snapshot;
+    saveSnapshot(src, snapshot);
+    DynamicJsonDocument dst(src.memoryUsage());
+
+    REQUIRE(loadSnapshot(dst, snapshot) == DeserializationError::Ok);
+    REQUIRE(dst.as<std::string>() == expected);
+  }
+
+  SECTION("buffer too small") {
+    char buffer[32];
+
+    REQUIRE(saveSnapshot(src, buffer, sizeof(buffer)) == sizeof(buffer));
+  }
+}
+
+#if !ARDUINOJSON_COMPACT_SLOTS
+TEST_CASE("saveSnapshot() refuses pointers outside of the pool") {
+  DynamicJsonDocument doc(1024);
+  std::string snapshot;
+
+  SECTION("linked string") {
+    doc["hello"] = "world";
+
+    REQUIRE(saveSnapshot(doc, snapshot) == 0);
+    REQUIRE(measureSnapshot(doc) == 0);
+  }
+
+  SECTION("linked key") {
+    doc[std::string("hello")] = std::string("world");
+    doc["world"] = 42;
+
+    REQUIRE(saveSnapshot(doc, snapshot) == 0);
+  }
+
+  SECTION("linked raw") {
+    doc.add(serialized("[1,2]"));
+
+    REQUIRE(saveSnapshot(doc, snapshot) == 0);
+  }
+
+  SECTION("shallow copy of another document") {
+    DynamicJsonDocument other(128);
+    deserializeJson(other, "[1,2,3]");
+    doc.add().shallowCopy(other);
+
+    REQUIRE(saveSnapshot(doc, snapshot) == 0);
+  }
+
+  SECTION("owned strings") {
+    doc[std::string("hello")] = std::string("world");
+    doc[std::string("raw")] = serialized(std::string("[1,2]"));
+
+    REQUIRE(saveSnapshot(doc, snapshot) == measureSnapshot(doc));
+    REQUIRE(snapshot.size() > 0);
+  }
+}
+#endif
@@ -166,6 +166,16 @@ TEST_CASE("IteratorReader") {
   }
 }
 
+TEST_CASE("IsRamReader") {
+  CHECK(IsRamReader<Reader<const char*> >::value == true);
+  CHECK(IsRamReader<Reader<unsigned char*> >::value == true);
+  CHECK(IsRamReader<BoundedReader<const char*> >::value == true);
+  CHECK(IsRamReader<Reader<std::string> >::value == true);
+  CHECK(IsRamReader<Reader<std::istringstream> >::value == false);
+  CHECK(IsRamReader<IteratorReader<std::string::const_iterator> >::value ==
+        false);
+}
+
 class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : _stream(s) {}
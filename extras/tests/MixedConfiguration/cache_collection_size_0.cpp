@@ -0,0 +1,16 @@
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 0") {
+  DynamicJsonDocument doc(4096);
+  JsonArray array = doc.to<JsonArray>();
+
+  array.add(1);
+  array.add(2);
+  array.remove(0);
+
+  REQUIRE(array.size() == 1);
+  REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));  // the slot is not freed
+}
@@ -0,0 +1,75 @@
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 1
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("JsonArray") {
+    JsonArray array = doc.to<JsonArray>();
+    REQUIRE(array.size() == 0);
+
+    array.add(1);
+    array.add(2);
+    array.add(3);
+    REQUIRE(array.size() == 3);
+
+    array.remove(1);
+    REQUIRE(array.size() == 2);
+
+    array[5] = 5;
+    REQUIRE(array.size() == 6);
+
+    array.clear();
+    REQUIRE(array.size() == 0);
+  }
+
+  SECTION("JsonObject") {
+    JsonObject object = doc.to<JsonObject>();
+    object["a"] = 1;
+    object["b"] = 2;
+    object["a"] = 3;
+    REQUIRE(object.size() == 2);
+
+    object.remove("a");
+    object.remove("z");
+    REQUIRE(object.size() == 1);
+  }
+
+  SECTION("Failed additions") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(2)> small;
+    small["a"] = 1;
+    small["b"] = 2;
+    small["c"] = 3;
+    small[std::string("d")] = 4;  // the slot is allocated, but not the key
+    REQUIRE(small.size() == 2);
+
+    small.clear();
+    JsonArray array = small.to<JsonArray>();
+    array.add(1);
+    array.add(2);
+    array.add(3);
+    REQUIRE(array.size() == 2);
+  }
+
+  SECTION("Copy and deserialization") {
+    REQUIRE(deserializeJson(doc, "{\"a\":[1,2,3],\"b\":{},\"a\":[4]}") ==
+            DeserializationError::Ok);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["a"].size() == 1);
+
+    DynamicJsonDocument copy(doc);
+    REQUIRE(copy.size() == 2);
+
+    REQUIRE(deserializeMsgPack(doc, "\x92\x01\x81\xA1x\x02") ==
+            DeserializationError::Ok);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc[1].size() == 1);
+
+    doc.shrinkToFit();
+    REQUIRE(doc.size() == 2);
+  }
+}
@@ -0,0 +1,48 @@
+#define ARDUINOJSON_NAMESPACE ArduinoJson_IndexThreshold
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX 1
+#define ARDUINOJSON_COLLECTION_INDEX_THRESHOLD 10
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <string>
+
+#include <catch.hpp>
+
+static std::string key(int i) {
+  char buffer[16];
+  sprintf(buffer, "key%d", i);
+  return buffer;
+}
+
+TEST_CASE("ARDUINOJSON_COLLECTION_INDEX_THRESHOLD == 10") {
+  DynamicJsonDocument doc(65536);
+
+  SECTION("Finds all members") {
+    JsonObject obj = doc.to<JsonObject>();
+    for (int i = 0; i < 200; i++)
+      obj[key(i)] = i;
+
+    REQUIRE(obj.size() == 200);
+    for (int i = 0; i < 200; i++)
+      REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj.containsKey("key200") == false);
+
+    obj.remove("key42");
+    REQUIRE(obj.containsKey("key42") == false);
+    REQUIRE(obj["key43"] == 43);
+  }
+
+  SECTION("Finds all elements") {
+    JsonArray arr = doc.to<JsonArray>();
+    for (int i = 0; i < 200; i++)
+      arr.add(i);
+
+    REQUIRE(arr.size() == 200);
+    for (size_t i = 0; i < 200; i++)
+      REQUIRE(arr[i] == i);
+
+    arr.remove(42);
+    REQUIRE(arr[42] == 43);
+    REQUIRE(arr[198] == 199);
+  }
+}
@@ -0,0 +1,23 @@
+#define ARDUINOJSON_COMPACT_SLOTS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_COMPACT_SLOTS == 0") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("const char* is linked") {
+    const char* value = "hello";
+    doc["key"] = value;
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+    REQUIRE(doc["key"].as<const char*>() == value);
+  }
+
+  SECTION("deserializeJson(char*) keeps the strings in the input") {
+    char input[] = "[\"hello\"]";
+    deserializeJson(doc, input);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+}
@@ -0,0 +1,185 @@
+#define ARDUINOJSON_COMPACT_SLOTS 1
+#include <ArduinoJson.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+static const char* json =
+    "{\"name\":\"sensor\",\"values\":[1,-2,3.5,true,null,\"x\"],"
+    "\"nested\":{\"a\":[{}],\"b\":{\"c\":[[]]}},\"raw\":[1,2]}";
+
+TEST_CASE("ARDUINOJSON_COMPACT_SLOTS == 1") {
+  SECTION("A slot takes 16 bytes on 64-bit hosts") {
+    if (sizeof(void*) == 8)
+      REQUIRE(JSON_ARRAY_SIZE(1) == 16);
+    REQUIRE(JSON_ARRAY_SIZE(1) <= 16);
+  }
+
+  SECTION("deserializeJson() and serializeJson()") {
+    DynamicJsonDocument doc(4096);
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    std::string output;
+    serializeJson(doc, output);
+    REQUIRE(output == json);
+    REQUIRE(doc["values"][2] == 3.5);
+    REQUIRE(doc["nested"]["b"]["c"].size() == 1);
+  }
+
+  SECTION("The root doesn't count in the capacity") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(2));
+    REQUIRE(doc.capacity() == JSON_ARRAY_SIZE(2));
+
+    doc.add(1);
+    doc.add(2);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.add(3) == false);
+  }
+
+  SECTION("StaticJsonDocument") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1) + 16> doc;
+    doc["hello"] = "world";
+
+    REQUIRE(doc.capacity() == JSON_OBJECT_SIZE(1) + 16);
+    REQUIRE(doc["hello"] == "world");
+  }
+
+  SECTION("const char* is copied") {
+    DynamicJsonDocument doc(4096);
+    const char* value = "hello";
+    doc[value] = value;
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(5));
+    REQUIRE(doc["hello"].as<const char*>() != value);
+    REQUIRE(doc["hello"] == "hello");
+  }
+
+  SECTION("serialized(const char*) is copied") {
+    DynamicJsonDocument doc(4096);
+    doc["raw"] = serialized("[1,2]");
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(3) +
+                                     JSON_STRING_SIZE(5));
+    REQUIRE(doc.as<std::string>() == "{\"raw\":[1,2]}");
+  }
+
+  SECTION("deserializeJson(char*) copies the strings") {
+    DynamicJsonDocument doc(4096);
+    char input[] = "[\"hello\"]";
+    deserializeJson(doc, input);
+    input[2] = 'j';
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(5));
+    REQUIRE(doc[0] == "hello");
+  }
+
+  SECTION("JsonLinesReader(char*) copies the strings") {
+    DynamicJsonDocument doc(4096);
+    char input[] = "[\"hello\"]\n[\"world\"]";
+    JsonLinesReader lines(input, sizeof(input) - 1);
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    input[2] = 'j';
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(5));
+    REQUIRE(doc[0] == "hello");
+
+    REQUIRE(lines.next(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == "world");
+  }
+
+  SECTION("shallowCopy() copies the value") {
+    DynamicJsonDocument source(4096);
+    deserializeJson(source, json);
+    DynamicJsonDocument doc(4096);
+
+    doc["copy"].shallowCopy(source);
+    source.clear();
+
+    REQUIRE(doc["copy"]["name"] == "sensor");
+    REQUIRE(doc["copy"]["values"].size() == 6);
+  }
+
+  SECTION("Copy, shrinkToFit(), and garbageCollect()") {
+    DynamicJsonDocument doc(4096);
+    deserializeJson(doc, json);
+
+    DynamicJsonDocument copy(doc);
+    REQUIRE(copy.as<std::string>() == json);
+
+    doc.remove("name");
+    doc.shrinkToFit();
+    REQUIRE(doc["nested"]["a"].size() == 1);
+    REQUIRE(doc["values"][5] == "x");
+
+    REQUIRE(copy.garbageCollect());
+    REQUIRE(copy.as<std::string>() == json);
+  }
+
+  SECTION("A relocated image can be read in place") {
+    std::vector<JsonFloat> image, relocated;  // aligned like a pointer
+    std::string expected;
+    {
+      DynamicJsonDocument doc(4096);
+      deserializeJson(doc, json);
+      doc["values"].remove(0);  // leaves a hole
+      serializeJson(doc, expected);
+
+      size_t size = measureJsonImage(doc);
+      image.resize(size / sizeof(JsonFloat));
+      REQUIRE(size % sizeof(JsonFloat) == 0);
+      REQUIRE(saveJsonImage(doc, &image[0], size - 1) == 0);
+      REQUIRE(saveJsonImage(doc, &image[0], size) == size);
+    }
+    relocated = image;
+    image.assign(image.size(), 0);
+    size_t size = relocated.size() * sizeof(JsonFloat);
+
+    JsonVariantConst root = viewJsonImage(&relocated[0], size);
+    REQUIRE(root.as<std::string>() == expected);
+    REQUIRE(root["nested"]["b"]["c"][0].size() == 0);
+    REQUIRE(root["values"][4] == "x");
+  }
+
+  SECTION("viewJsonImage() checks the image") {
+    DynamicJsonDocument doc(4096);
+    doc.set("hello");
+    std::vector<JsonFloat> image(measureJsonImage(doc) / sizeof(JsonFloat));
+    size_t size = saveJsonImage(doc, &image[0], image.size() * 8);
+    REQUIRE(viewJsonImage(&image[0], size) == "hello");
+
+    REQUIRE(viewJsonImage(&image[0], size - 8).isNull());
+    reinterpret_cast<char*>(&image[0])[0] = 'X';
+    REQUIRE(viewJsonImage(&image[0], size).isNull());
+  }
+
+  SECTION("viewJsonImage() rejects an image from another platform") {
+    DynamicJsonDocument doc(4096);
+    doc.set("hello");
+    std::vector<JsonFloat> image(measureJsonImage(doc) / sizeof(JsonFloat));
+    size_t size = saveJsonImage(doc, &image[0], image.size() * 8);
+    ARDUINOJSON_NAMESPACE::JsonImageHeader* header =
+        reinterpret_cast<ARDUINOJSON_NAMESPACE::JsonImageHeader*>(&image[0]);
+
+    header->layout ^= 0x10000;  // the other endianness
+    REQUIRE(viewJsonImage(&image[0], size).isNull());
+  }
+
+#if ARDUINOJSON_HAS_RVALUE_REFERENCES
+  SECTION("Move") {
+    DynamicJsonDocument doc(4096);
+    deserializeJson(doc, json);
+
+    DynamicJsonDocument moved(std::move(doc));
+    REQUIRE(moved.as<std::string>() == json);
+    REQUIRE(doc.isNull());
+    REQUIRE(doc.capacity() == 0);
+
+    doc.to<JsonArray>();  // the root is outside of the pool
+    REQUIRE(doc.as<std::string>() == "[]");
+  }
+#endif
+}
@@ -0,0 +1,18 @@
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_COLLECTION_INDEX == 0") {
+  static const char* keys[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i",
+                               "j", "k", "l", "m", "n", "o", "p", "q", "r"};
+  const int n = sizeof(keys) / sizeof(keys[0]);
+  DynamicJsonDocument doc(4096);
+
+  for (int i = 0; i < n; i++)
+    doc[keys[i]] = i;
+
+  REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(n));
+  for (int i = 0; i < n; i++)
+    REQUIRE(doc[keys[i]] == i);
+}
@@ -0,0 +1,287 @@
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX 1
+#define ARDUINOJSON_COLLECTION_INDEX_THRESHOLD 16
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+static std::string key(int i) {
+  char buffer[16];
+  sprintf(buffer, "key%d", i);
+  return buffer;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_COLLECTION_INDEX == 1") {
+  DynamicJsonDocument doc(65536);
+  JsonObject obj = doc.to<JsonObject>();
+
+  SECTION("Finds all members") {
+    for (int i = 0; i < 300; i++)
+      obj[key(i)] = i;
+
+    REQUIRE(obj.size() == 300);
+    for (int i = 0; i < 300; i++)
+      REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj.containsKey("key300") == false);
+    REQUIRE(obj.containsKey("") == false);
+  }
+
+  SECTION("Only large objects get a table") {
+    for (int i = 0; i < 16; i++)
+      obj[key(i)] = i;
+    size_t usage = doc.memoryUsage();
+    REQUIRE(usage == JSON_OBJECT_SIZE(16) + 16 * 6 - 10 * 1);
+
+    obj[key(16)] = 16;
+    REQUIRE(doc.memoryUsage() > usage + JSON_OBJECT_SIZE(1) + 6);
+  }
+
+  SECTION("Removes members") {
+    for (int i = 0; i < 100; i++)
+      obj[key(i)] = i;
+    for (int i = 0; i < 100; i += 3)
+      obj.remove(key(i));
+    for (int i = 100; i < 200; i++)
+      obj[key(i)] = i;
+
+    for (int i = 0; i < 200; i++) {
+      if (i < 100 && i % 3 == 0)
+        REQUIRE(obj.containsKey(key(i)) == false);
+      else
+        REQUIRE(obj[key(i)] == i);
+    }
+  }
+
+  SECTION("Removes the last members") {
+    for (int i = 0; i < 20; i++)
+      obj[key(i)] = i;
+    for (int i = 19; i >= 0; i--) {
+      obj.remove(key(i));
+      REQUIRE(obj.containsKey(key(i)) == false);
+    }
+    REQUIRE(obj.size() == 0);
+
+    for (int i = 0; i < 20; i++)
+      obj[key(i)] = i;
+    for (int i = 0; i < 20; i++)
+      REQUIRE(obj[key(i)] == i);
+  }
+
+  SECTION("Random operations") {
+    std::map<std::string, int> expected;
+    uint32_t seed = 42;  // a simple LCG, so the test is reproducible
+    for (int i = 0; i < 5000; i++) {
+      seed = seed * 1664525 + 1013904223;
+      std::string k = key(int(seed >> 26));  // 64 different keys
+      if (seed & 0x100) {
+        obj[k] = i;
+        expected[k] = i;
+      } else {
+        obj.remove(k);
+        expected.erase(k);
+      }
+    }
+
+    REQUIRE(obj.size() == expected.size());
+    for (int i = 0; i < 64; i++) {
+      std::map<std::string, int>::iterator it = expected.find(key(i));
+      if (it == expected.end())
+        REQUIRE(obj.containsKey(key(i)) == false);
+      else
+        REQUIRE(obj[key(i)] == it->second);
+    }
+  }
+
+  SECTION("deserializeJson() with duplicate keys") {
+    std::string json = "{";
+    for (int i = 0; i < 100; i++)
+      json += "\"" + key(i) + "\":" + key(i).substr(3) + ",";
+    json += "\"key42\":-1}";
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc["key41"] == 41);
+    REQUIRE(doc["key42"] == -1);
+  }
+
+  SECTION("shrinkToFit() and garbageCollect() move the table") {
+    for (int i = 0; i < 100; i++)
+      doc[key(i)] = i;
+
+    doc.shrinkToFit();
+    for (int i = 0; i < 100; i++)
+      REQUIRE(doc[key(i)] == i);
+
+    doc.garbageCollect();
+    for (int i = 0; i < 100; i++)
+      REQUIRE(doc[key(i)] == i);
+  }
+
+  SECTION("compact() rebuilds the table") {
+    for (int i = 0; i < 100; i++)
+      doc[key(i)] = i;
+    for (int i = 0; i < 100; i += 2)
+      doc.remove(key(i));
+
+    doc.compact();
+
+    REQUIRE(doc.size() == 50);
+    for (int i = 1; i < 100; i += 2)
+      REQUIRE(doc[key(i)] == i);
+    REQUIRE(doc[key(0)].isNull());
+    for (int i = 100; i < 200; i++)
+      doc[key(i)] = i;
+    for (int i = 100; i < 200; i++)
+      REQUIRE(doc[key(i)] == i);
+  }
+
+  SECTION("compact() drops the table of an empty object") {
+    JsonObject nested = doc.createNestedObject("nested");
+    for (int i = 0; i < 100; i++)
+      nested[key(i)] = i;
+    for (int i = 0; i < 100; i++)
+      nested.remove(key(i));
+    for (int i = 0; i < 100; i++)
+      doc[key(i)] = i;
+
+    doc.compact();
+    nested = doc["nested"];
+    for (int i = 0; i < 100; i++)
+      nested[key(i)] = i;
+    nested.remove(key(50));
+
+    REQUIRE(nested.size() == 99);
+    REQUIRE(nested[key(99)] == 99);
+    REQUIRE(doc[key(99)] == 99);
+  }
+
+  SECTION("freeze() completes the tables") {
+    for (int i = 0; i < 16; i++)
+      obj[key(i)] = i;
+    JsonArray arr = obj.createNestedArray("arr");
+    for (int i = 0; i < 16; i++)
+      arr.add(i);
+    size_t usage = doc.memoryUsage();
+
+    doc.freeze();
+
+    REQUIRE(doc.isFrozen() == true);
+    REQUIRE(doc.memoryUsage() > usage);
+    for (int i = 0; i < 16; i++) {
+      REQUIRE(obj[key(i)] == i);
+      REQUIRE(arr[static_cast<size_t>(i)] == i);
+    }
+
+    usage = doc.memoryUsage();
+    doc.freeze();
+    REQUIRE(doc.memoryUsage() == usage);
+  }
+
+  SECTION("Finds all elements") {
+    JsonArray arr = doc.to<JsonArray>();
+    for (int i = 0; i < 300; i++)
+      arr.add(i);
+
+    REQUIRE(arr.size() == 300);
+    for (size_t i = 0; i < 300; i++)
+      REQUIRE(arr[i] == i);
+    REQUIRE(arr[300].isNull());
+
+    for (size_t i = 0; i < 300; i++)
+      arr[i] = -int(i);
+    arr[302] = 302;
+    REQUIRE(arr.size() == 303);
+    REQUIRE(arr[299] == -299);
+    REQUIRE(arr[300].isNull());
+    REQUIRE(arr[302] == 302);
+  }
+
+  SECTION("Only large arrays get a table") {
+    JsonArray arr = doc.to<JsonArray>();
+    for (int i = 0; i < 16; i++)
+      arr.add(i);
+    size_t usage = doc.memoryUsage();
+    REQUIRE(usage == JSON_ARRAY_SIZE(16));
+
+    arr.add(16);
+    REQUIRE(doc.memoryUsage() > usage + JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("Removes elements") {
+    JsonArray arr = doc.to<JsonArray>();
+    std::vector<int> expected;
+    for (int i = 0; i < 100; i++) {
+      arr.add(i);
+      expected.push_back(i);
+    }
+
+    // the head, the middle, and the tail
+    size_t positions[] = {0, 50, 97, 96, 10, 10, 0};
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+      arr.remove(positions[i]);
+      expected.erase(expected.begin() + long(positions[i]));
+    }
+    for (int i = 100; i < 150; i++) {
+      arr.add(i);
+      expected.push_back(i);
+    }
+
+    REQUIRE(arr.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+      REQUIRE(arr[i] == expected[i]);
+  }
+
+  SECTION("deserializeJson() and shrinkToFit() with an array") {
+    std::string json = "[";
+    for (int i = 0; i < 100; i++)
+      json += key(i).substr(3) + ",{\"a\":[1,2]},";
+    json += "-1]";
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+    doc.shrinkToFit();
+
+    REQUIRE(doc.size() == 201);
+    for (size_t i = 0; i < 100; i++) {
+      REQUIRE(doc[2 * i] == i);
+      REQUIRE(doc[2 * i + 1]["a"][1] == 2);
+    }
+    REQUIRE(doc[200] == -1);
+  }
+
+  SECTION("estimateJsonCapacity() counts the tables") {
+    for (int n = 10; n <= 300; n += 10) {
+      std::string json = "{";
+      for (int i = 0; i < n; i++)
+        json += "\"" + key(i) + "\":[" + key(i).substr(3) + "],";
+      json += "\"a\":[";
+      for (int i = 0; i < n; i++)
+        json += "0,";
+      json += "0]}";
+
+      size_t capacity = estimateJsonCapacity(json);
+      DynamicJsonDocument exact(capacity);
+      REQUIRE(deserializeJson(exact, json) == DeserializationError::Ok);
+      REQUIRE(exact.memoryUsage() == capacity);
+    }
+  }
+
+  SECTION("Works without a table when the pool is full") {
+    static char keys[17][8];
+    StaticJsonDocument<JSON_OBJECT_SIZE(17)> small;
+
+    for (int i = 0; i < 17; i++) {
+      sprintf(keys[i], "key%d", i);
+      small[static_cast<const char*>(keys[i])] = i;  // linked, not copied
+    }
+
+    REQUIRE(small.overflowed() == false);
+    REQUIRE(small.size() == 17);
+    for (int i = 0; i < 17; i++)
+      REQUIRE(small[static_cast<const char*>(keys[i])] == i);
+  }
+}
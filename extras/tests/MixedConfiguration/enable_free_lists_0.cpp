@@ -0,0 +1,15 @@
+#define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS == 0") {
+  DynamicJsonDocument doc(4096);
+  doc["a"] = 1;
+  doc["b"] = 2;
+
+  doc.remove("a");
+  doc["a"] = 3;
+
+  REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(3));
+}
@@ -0,0 +1,113 @@
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+#define ARDUINOJSON_ENABLE_STRING_DEDUPLICATION 0
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <string>
+
+#include <catch.hpp>
+
+static std::string str(const char* prefix, int i) {
+  char buffer[32];
+  sprintf(buffer, "%s%d", prefix, i);
+  return buffer;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("Reuses the slots of the removed members") {
+    doc["alpha"] = 1;
+    doc["bravo"] = 2;
+    doc["charlie"] = 3;
+    size_t usage = doc.memoryUsage();
+
+    for (int i = 0; i < 100; i++) {
+      doc.remove("alpha");
+      doc["alpha"] = i;
+    }
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"bravo\":2,\"charlie\":3,\"alpha\":99}");
+  }
+
+  SECTION("Reuses the replaced strings") {
+    doc["status"] = std::string("starting");
+    doc["other"] = std::string("value");
+    size_t usage = doc.memoryUsage();
+
+    for (int i = 0; i < 100; i++)
+      doc["status"] = std::string(i % 2 ? "running" : "stopping");
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(doc["status"] == "running");
+  }
+
+  SECTION("Reuses the removed collections and their strings") {
+    size_t usage = 0;
+    for (int i = 0; i < 100; i++) {
+      doc.remove("list");
+      JsonArray list = doc.createNestedArray(std::string("list"));
+      list.add(str("first", i));
+      list.add(str("second", i));
+      list.createNestedObject()[str("third", i % 10)] = i;
+      doc[std::string("other")] = str("value", i);
+      if (i == 11)  // same lengths as the last ones
+        usage = doc.memoryUsage();
+    }
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"other\":\"value99\","
+            "\"list\":[\"first99\",\"second99\",{\"third9\":99}]}");
+  }
+
+  SECTION("Splits a larger string") {
+    doc.add(std::string("a very long string"));
+    doc.add(std::string("last"));
+    size_t usage = doc.memoryUsage();
+
+    doc.remove(0);
+    doc.add(std::string("short"));
+    doc.add(std::string("string"));
+
+    REQUIRE(doc.memoryUsage() == usage + JSON_ARRAY_SIZE(1));
+    REQUIRE(doc.as<std::string>() == "[\"last\",\"short\",\"string\"]");
+  }
+
+  SECTION("Gives back the last string and the last slot") {
+    doc.add(std::string("first"));
+    doc.add(std::string("last"));
+
+    doc.remove(1);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + 6);
+  }
+
+  SECTION("An iterator can move past a removed element") {
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < 10; i++)
+      array.add(str("value", i));
+
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it) {
+      if (it->as<std::string>() != "value3")
+        array.remove(it);
+    }
+
+    REQUIRE(doc.as<std::string>() == "[\"value3\"]");
+  }
+
+  SECTION("clear() and compact() empty the lists") {
+    for (int i = 0; i < 10; i++)
+      doc.add(str("value", i));
+    doc.remove(3);
+    doc.remove(3);
+
+    doc.compact();
+    doc.add(std::string("value10"));
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(9) + 8 * 7 + 8);
+    REQUIRE(doc[8] == "value10");
+  }
+}
@@ -0,0 +1,13 @@
+#define ARDUINOJSON_ENABLE_POOL_GROWTH 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_POOL_GROWTH == 0") {
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(2));
+
+  DeserializationError err = deserializeJson(doc, "[1,2,3]");
+
+  REQUIRE(err == DeserializationError::NoMemory);
+  REQUIRE(doc.capacity() == JSON_ARRAY_SIZE(2));
+}
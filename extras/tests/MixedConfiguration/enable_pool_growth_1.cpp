@@ -0,0 +1,161 @@
+#define ARDUINOJSON_ENABLE_POOL_GROWTH 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <stdlib.h>  // malloc, free
+#include <string>
+
+#include <catch.hpp>
+
+class CountingAllocator {
+ public:
+  CountingAllocator(int& blocks, int limit = 1000000)
+      : _blocks(&blocks), _limit(limit) {}
+
+  void* allocate(size_t n) {
+    if (*_blocks >= _limit)
+      return 0;
+    ++*_blocks;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) {
+    --*_blocks;
+    free(p);
+  }
+
+  void* reallocate(void* p, size_t n) {
+    return realloc(p, n);
+  }
+
+ private:
+  int* _blocks;
+  int _limit;
+};
+
+typedef BasicJsonDocument<CountingAllocator> CountingJsonDocument;
+
+static std::string makeJson(int n) {
+  std::string json = "[";
+  for (int i = 0; i < n; i++) {
+    char buffer[64];
+    sprintf(buffer, "{\"id\":%d,\"name\":\"sensor-%d\"},", i, i);
+    json += buffer;
+  }
+  return json + "{}]";
+}
+
+static void checkDocument(JsonDocument& doc, size_t n) {
+  REQUIRE(doc.size() == n + 1);
+  for (size_t i = 0; i < n; i++) {
+    char name[32];
+    sprintf(name, "sensor-%d", int(i));
+    REQUIRE(doc[i]["id"] == i);
+    REQUIRE(doc[i]["name"] == name);
+  }
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_POOL_GROWTH == 1") {
+  int blocks = 0;
+
+  SECTION("deserializeJson() adds blocks") {
+    CountingJsonDocument doc(256, blocks);
+
+    REQUIRE(deserializeJson(doc, makeJson(500)) == DeserializationError::Ok);
+
+    checkDocument(doc, 500);
+    REQUIRE(blocks > 2);
+    REQUIRE(doc.capacity() > 256);
+    REQUIRE(doc.memoryUsage() <= doc.capacity());
+    REQUIRE(doc.overflowed() == false);
+  }
+
+  SECTION("Strings longer than a block") {
+    DynamicJsonDocument doc(1024);
+    std::string value(5000, 'x');
+
+    REQUIRE(deserializeJson(doc, "[\"" + value + "\",\"" + value + "\"]") ==
+            DeserializationError::Ok);
+    doc.add(value + "y");
+
+    REQUIRE(doc[0] == value);
+    REQUIRE(doc[0].as<const char*>() == doc[1].as<const char*>());
+    REQUIRE(doc[2] == value + "y");
+  }
+
+  SECTION("References remain valid") {
+    DynamicJsonDocument doc(256);
+    JsonArray first = doc.createNestedArray();
+    JsonObject object = doc.createNestedObject();
+
+    for (int i = 0; i < 1000; i++) {
+      first.add(i);
+      object[std::string("key") + char('a' + i % 26)] = i;
+    }
+
+    REQUIRE(first.size() == 1000);
+    REQUIRE(first[999] == 999);
+    REQUIRE(object.size() == 26);
+    REQUIRE(object["keyz"] == 987);
+  }
+
+  SECTION("A small document grows too") {
+    // the blocks must be large enough to get the same size as the first one,
+    // or the allocator may put them too far (ASan does)
+    DynamicJsonDocument doc(64);
+
+    for (int i = 0; i < 1000; i++)
+      REQUIRE(doc.add(i));
+
+    REQUIRE(doc.size() == 1000);
+    REQUIRE(doc.overflowed() == false);
+  }
+
+  SECTION("clear() and the destructor release the blocks") {
+    {
+      CountingJsonDocument doc(256, blocks);
+      deserializeJson(doc, makeJson(100));
+      REQUIRE(blocks > 1);
+
+      doc.clear();
+      REQUIRE(blocks == 1);
+      REQUIRE(doc.capacity() == 256);
+
+      deserializeJson(doc, makeJson(100));
+    }
+    REQUIRE(blocks == 0);
+  }
+
+  SECTION("Copy, garbageCollect(), and shrinkToFit()") {
+    CountingJsonDocument doc(256, blocks);
+    deserializeJson(doc, makeJson(100));
+
+    CountingJsonDocument copy(doc);
+    checkDocument(copy, 100);
+
+    REQUIRE(doc.garbageCollect());
+    checkDocument(doc, 100);
+
+    deserializeJson(doc, makeJson(100));
+    doc.shrinkToFit();
+    checkDocument(doc, 100);
+    REQUIRE(doc.capacity() < doc.memoryUsage() + sizeof(void*));
+
+    copy.clear();
+    REQUIRE(blocks == 2);
+  }
+
+  SECTION("NoMemory when the allocator fails") {
+    CountingJsonDocument doc(256, CountingAllocator(blocks, 3));
+
+    REQUIRE(deserializeJson(doc, makeJson(500)) ==
+            DeserializationError::NoMemory);
+    REQUIRE(blocks == 3);
+  }
+
+  SECTION("StaticJsonDocument doesn't grow") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> doc;
+
+    REQUIRE(deserializeJson(doc, "[1,2,3]") == DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,19 @@
+#define ARDUINOJSON_ENABLE_STRING_TABLE 0
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_TABLE == 0") {
+  DynamicJsonDocument doc(16384);
+
+  for (int i = 0; i < 100; i++) {
+    char value[8];
+    sprintf(value, "s%02d", i % 50);
+    doc.add(value);
+  }
+
+  REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(100) + 50 * 4);
+  REQUIRE(doc[60].as<const char*>() == doc[10].as<const char*>());
+}
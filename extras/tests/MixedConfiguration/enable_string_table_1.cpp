@@ -0,0 +1,114 @@
+#define ARDUINOJSON_ENABLE_STRING_TABLE 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <string>
+
+#include <catch.hpp>
+
+static std::string str(int i) {
+  char buffer[16];
+  sprintf(buffer, "s%02d", i);
+  return buffer;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_TABLE == 1") {
+  DynamicJsonDocument doc(65536);
+
+  SECTION("Only large pools get a table") {
+    for (int i = 0; i < 31; i++)
+      doc.add(str(i));
+    size_t usage = doc.memoryUsage();
+    REQUIRE(usage == JSON_ARRAY_SIZE(31) + 31 * 4);
+
+    doc.add(str(31));
+    REQUIRE(doc.memoryUsage() > usage + JSON_ARRAY_SIZE(1) + 4);
+  }
+
+  SECTION("Deduplicates values") {
+    for (int i = 0; i < 1000; i++)
+      doc.add(str(i % 300));
+
+    for (size_t i = 300; i < 1000; i++)
+      REQUIRE(doc[i].as<const char*>() == doc[i % 300].as<const char*>());
+    REQUIRE(doc[299] == "s299");
+  }
+
+  SECTION("deserializeJson() deduplicates keys") {
+    std::string json = "[";
+    for (int i = 0; i < 200; i++)
+      json += "{\"" + str(i % 100) + "\":1,\"id\":" + str(i).substr(1) + "},";
+    json += "{}]";
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    for (size_t i = 0; i < 100; i++) {
+      REQUIRE(doc[i + 100][str(int(i))] == 1);
+      const char* key1 = doc[i].as<JsonObject>().begin()->key().c_str();
+      const char* key2 = doc[i + 100].as<JsonObject>().begin()->key().c_str();
+      REQUIRE(key1 == key2);
+    }
+  }
+
+  SECTION("shrinkToFit() and garbageCollect() move the table") {
+    using namespace ARDUINOJSON_NAMESPACE;
+
+    for (int i = 0; i < 100; i++)
+      doc.add(str(i));
+    MemoryPool& pool = doc.memoryPool();
+
+    // the pool is full, so the strings can only come from the table
+    doc.shrinkToFit();
+    for (size_t i = 0; i < 100; i++)
+      REQUIRE(pool.saveString(adaptString(str(int(i)))) ==
+              doc[i].as<const char*>());
+
+    doc.garbageCollect();
+    for (size_t i = 0; i < 100; i++)
+      REQUIRE(pool.saveString(adaptString(str(int(i)))) ==
+              doc[i].as<const char*>());
+    REQUIRE(doc.overflowed() == false);
+  }
+
+  SECTION("compact() rebuilds the table") {
+    using namespace ARDUINOJSON_NAMESPACE;
+
+    for (int i = 0; i < 100; i++)
+      doc.add(str(i));
+    for (int i = 0; i < 50; i++)
+      doc.remove(0);
+
+    doc.compact();
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(50) + 50 * 4 +
+                                     MemoryPool::stringTableMemoryUsage(50));
+    MemoryPool& pool = doc.memoryPool();
+    for (size_t i = 0; i < 50; i++)
+      REQUIRE(pool.saveString(adaptString(str(int(i + 50)))) ==
+              doc[i].as<const char*>());
+  }
+
+  SECTION("estimateJsonCapacity() counts the tables") {
+    for (int n = 30; n <= 300; n += 30) {
+      std::string json = "[";
+      for (int i = 0; i < n; i++)
+        json += "\"" + str(i) + "\",";
+      json += "0]";
+
+      size_t capacity = estimateJsonCapacity(json);
+      DynamicJsonDocument exact(capacity);
+      REQUIRE(deserializeJson(exact, json) == DeserializationError::Ok);
+      REQUIRE(exact.memoryUsage() == capacity);
+    }
+  }
+
+  SECTION("Works without a table when the pool is full") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(64) + 32 * 4> small;
+    for (int i = 0; i < 64; i++)
+      small.add(str(i % 32));
+
+    REQUIRE(small.overflowed() == false);
+    for (size_t i = 32; i < 64; i++)
+      REQUIRE(small[i].as<const char*>() == small[i - 32].as<const char*>());
+  }
+}
@@ -0,0 +1,13 @@
+#define ARDUINOJSON_FAST_FLOAT 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_FAST_FLOAT == 0") {
+  DynamicJsonDocument doc(4096);
+
+  deserializeJson(doc, "[3.14,-1.5e-3]");
+
+  REQUIRE(doc[0].as<double>() == Approx(3.14));
+  REQUIRE(doc[1].as<double>() == Approx(-1.5e-3));
+}
@@ -0,0 +1,80 @@
+#define ARDUINOJSON_FAST_FLOAT 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <catch.hpp>
+
+static void checkExact(const char* input) {
+  CAPTURE(input);
+  double expected = strtod(input, 0);
+  double actual = ARDUINOJSON_NAMESPACE::parseNumber<double>(input);
+  uint64_t expectedBits, actualBits;
+  memcpy(&expectedBits, &expected, 8);
+  memcpy(&actualBits, &actual, 8);
+  CHECK(actualBits == expectedBits);
+}
+
+TEST_CASE("ARDUINOJSON_FAST_FLOAT == 1") {
+  SECTION("Correctly rounded") {
+    const char* inputs[] = {
+        "3.14",
+        "-52.20813485313412",
+        "160.297450399412",
+        "0.1",
+        "1e23",
+        "8.98846567431158e307",
+        "1.7976931348623157e308",
+        "2.2250738585072014e-308",
+        "2.2250738585072011e-308",  // subnormal
+        "4.9406564584124654e-324",  // smallest subnormal
+        "2.4703282292062328e-324",  // rounds up to smallest subnormal
+        "9007199254740993",         // 2^53 + 1, tie to even
+        "9007199254740995",
+        "7.038531e-26",
+        "123456789012345678901234567890",  // truncated mantissa
+        "0.000000000000000000000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "1e-400",
+        "-1e400",
+        "0.0",
+        "-0.0",
+        "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180817996189898282347722858865463328355177969898199387398005390939063150356595155702263922908583924491051844359318028499365361525003193704576782492193656236698636584807570015857692699037063119282795585513329278343384093519780155312465972635795746227664652728272200563740064854999770965994704540208281662262378573934507363390079677619305775067401763246736009689513405355374585166611342237666786041621596804619144672918403005300575308490487653917113865916462395249126236538818796362393732804238910186723484976682350898633885879256283027559956575244555072551893136908362547791869486679949683240497058210285131854513962138377228261454376934125320985913276672363281255e-324",
+        "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180817996189898282347722858865463328355177969898199387398005390939063150356595155702263922908583924491051844359318028499365361525003193704576782492193656236698636584807570015857692699037063119282795585513329278343384093519780155312465972635795746227664652728272200563740064854999770965994704540208281662262378573934507363390079677619305775067401763246736009689513405355374585166611342237666786041621596804619144672918403005300575308490487653917113865916462395249126236538818796362393732804238910186723484976682350898633885879256283027559956575244555072551893136908362547791869486679949683240497058210285131854513962138377228261454376934125320985913276672363281249e-324",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      checkExact(inputs[i]);
+  }
+
+  SECTION("Round trips") {
+    // a simple LCG, so the test is reproducible
+    uint32_t seed = 42;
+    for (int i = 0; i < 10000; i++) {
+      uint64_t bits = 0;
+      for (int j = 0; j < 2; j++) {
+        seed = seed * 1664525 + 1013904223;
+        bits = (bits << 32) | seed;
+      }
+      bits &= ~(uint64_t(0x80100000) << 32);  // positive and finite
+      double value;
+      memcpy(&value, &bits, 8);
+      char buffer[32];
+      sprintf(buffer, "%.17g", value);
+      checkExact(buffer);
+    }
+  }
+
+  SECTION("deserializeJson()") {
+    DynamicJsonDocument doc(4096);
+
+    deserializeJson(doc, "[0.1,-52.20813485313412,1e23]");
+
+    REQUIRE(doc[0].as<double>() == 0.1);
+    REQUIRE(doc[1].as<double>() == -52.20813485313412);
+    REQUIRE(doc[2].as<double>() == 1e23);
+  }
+}
@@ -0,0 +1,60 @@
+// The slots can only be linked to the slots that are less than 128 slots away,
+// so the blocks of the allocator below are out of reach of each other
+#define ARDUINOJSON_SLOT_OFFSET_SIZE 1
+#define ARDUINOJSON_ENABLE_POOL_GROWTH 1
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX 1
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+// Puts the large blocks far from the small ones, like an allocator with size
+// classes
+class FarAllocator {
+ public:
+  FarAllocator() : _small(0), _large(0) {}
+
+  void* allocate(size_t n) {
+    size_t& used = n < largeSize ? _small : _large;
+    char* area = n < largeSize ? _buffer : _buffer + areaSize;
+    n = (n + 15) / 16 * 16;
+    if (used + n > areaSize)
+      return 0;
+    void* p = area + used;
+    used += n;
+    return p;
+  }
+
+  void deallocate(void*) {}
+
+  void* reallocate(void*, size_t) {
+    return 0;
+  }
+
+ private:
+  static const size_t largeSize = 200;
+  static const size_t areaSize = 16384;
+
+  union {
+    char _buffer[2 * areaSize];
+    double _alignment;
+  };
+  size_t _small, _large;
+};
+
+typedef BasicJsonDocument<FarAllocator> FarJsonDocument;
+
+TEST_CASE("ARDUINOJSON_ENABLE_POOL_GROWTH with blocks out of reach") {
+  FarJsonDocument doc(128);
+
+  SECTION("The slots stay in the blocks that can hold them") {
+    // the tables of the index go in the large blocks, and the removed tables
+    // must not be used as slots
+    for (int i = 0; i < 40; i++)
+      doc.add(i);
+
+    REQUIRE(doc.size() == 40);
+    for (size_t i = 0; i < 40; i++)
+      REQUIRE(doc[i] == i);
+  }
+}
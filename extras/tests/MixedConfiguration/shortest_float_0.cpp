@@ -0,0 +1,15 @@
+#define ARDUINOJSON_SHORTEST_FLOAT 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_SHORTEST_FLOAT == 0") {
+  DynamicJsonDocument doc(4096);
+  doc.add(3.14159265359);
+  doc.add(0.1);
+
+  std::string json;
+  serializeJson(doc, json);
+
+  REQUIRE(json == "[3.141592654,0.1]");
+}
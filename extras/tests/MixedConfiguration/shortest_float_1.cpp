@@ -0,0 +1,74 @@
+#define ARDUINOJSON_SHORTEST_FLOAT 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <catch.hpp>
+
+static std::string serialize(double value) {
+  DynamicJsonDocument doc(4096);
+  doc.set(value);
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+TEST_CASE("ARDUINOJSON_SHORTEST_FLOAT == 1") {
+  SECTION("Shortest representation") {
+    CHECK(serialize(3.14159265359) == "3.14159265359");
+    CHECK(serialize(0.1) == "0.1");
+    CHECK(serialize(-52.20813485313412) == "-52.20813485313412");
+    CHECK(serialize(0.30000000000000004) == "0.30000000000000004");
+    CHECK(serialize(1.7976931348623157e308) == "1.7976931348623157e308");
+    CHECK(serialize(2.2250738585072014e-308) == "2.2250738585072014e-308");
+    CHECK(serialize(4.9406564584124654e-324) == "5e-324");  // subnormal
+    CHECK(serialize(9007199254740993.0) == "9.007199254740992e15");
+    CHECK(serialize(5e-324 * 3) == "1.5e-323");
+  }
+
+  SECTION("Same layout as before") {
+    CHECK(serialize(0) == "0");
+    CHECK(serialize(-0.0) == "0");
+    CHECK(serialize(42) == "42");
+    CHECK(serialize(1200) == "1200");
+    CHECK(serialize(-1.5) == "-1.5");
+    CHECK(serialize(0.00012) == "0.00012");
+    CHECK(serialize(1e-5) == "1e-5");
+    CHECK(serialize(9999999.999) == "9999999.999");
+    CHECK(serialize(1e7) == "1e7");
+    CHECK(serialize(1.25e20) == "1.25e20");
+    CHECK(serialize(-2.5e-100) == "-2.5e-100");
+  }
+
+  SECTION("float") {
+    DynamicJsonDocument doc(4096);
+    doc.set(3.14159265359f);
+    std::string json;
+    serializeJson(doc, json);
+    CHECK(json == "3.1415927410125732");  // the double nearest to the float
+  }
+
+  SECTION("Round trips") {
+    // a simple LCG, so the test is reproducible
+    uint32_t seed = 42;
+    for (int i = 0; i < 10000; i++) {
+      uint64_t bits = 0;
+      for (int j = 0; j < 2; j++) {
+        seed = seed * 1664525 + 1013904223;
+        bits = (bits << 32) | seed;
+      }
+      bits &= ~(uint64_t(0x00100000) << 32);  // finite
+      double value;
+      memcpy(&value, &bits, 8);
+
+      std::string json = serialize(value);
+      CAPTURE(json);
+      double actual = strtod(json.c_str(), 0);
+      uint64_t actualBits;
+      memcpy(&actualBits, &actual, 8);
+      CHECK(actualBits == bits);
+    }
+  }
+}
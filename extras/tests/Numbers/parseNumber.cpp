@@ -55,3 +55,70 @@ TEST_CASE("Invalid value") {
 
   REQUIRE(result.type() == uint8_t(VALUE_IS_NULL));
 }
+
+static bool isDigitOrLetter(char c) {
+  return isdigit(c) || isalpha(c) || c == '.' || c == '-' || c == '+';
+}
+
+TEST_CASE("parseInteger()") {
+  VariantData expected, actual;
+  expected.init();
+  actual.init();
+
+  SECTION("Same result as parseNumber()") {
+    // crosses the 8-digit chunks and the overflow limits
+    std::string digits = "1234567890123456789012345";
+    for (size_t i = 1; i <= digits.size(); i++) {
+      std::string inputs[] = {digits.substr(0, i), "-" + digits.substr(0, i)};
+      for (size_t j = 0; j < 2; j++) {
+        const std::string& input = inputs[j];
+        CAPTURE(input);
+        actual.init();
+        parseNumber(input.c_str(), expected);
+
+        const char* end = input.c_str() + input.size();
+        const char* p =
+            parseInteger(input.c_str(), end, isDigitOrLetter, actual);
+
+        if (i <= 9)
+          CHECK(p == end);  // always fits
+        if (p) {
+          CHECK(p == end);
+          CHECK(actual.type() == expected.type());
+          CHECK(actual.asIntegral<Integer>() == expected.asIntegral<Integer>());
+          CHECK(actual.asIntegral<UInt>() == expected.asIntegral<UInt>());
+        } else {
+          CHECK(expected.type() != uint8_t(VALUE_IS_SIGNED_INTEGER));
+          CHECK(actual.isNull());
+        }
+      }
+    }
+  }
+
+  SECTION("Stops at delimiter") {
+    const char input[] = "1234567890,";
+    const char* p =
+        parseInteger(input, input + sizeof(input) - 1, isDigitOrLetter, actual);
+
+    REQUIRE(p == input + 10);
+    REQUIRE(actual.asIntegral<long>() == 1234567890L);
+  }
+
+  SECTION("Only reads up to end") {
+    const char input[] = "123456789";
+    const char* p = parseInteger(input, input + 3, isDigitOrLetter, actual);
+
+    REQUIRE(p == input + 3);
+    REQUIRE(actual.asIntegral<int>() == 123);
+  }
+
+  SECTION("Rejects floats and garbage") {
+    const char* inputs[] = {"1.5", "1e3", "12345678.9", "1x", "+1", "-", "x"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      CAPTURE(inputs[i]);
+      const char* end = inputs[i] + strlen(inputs[i]);
+      CHECK(parseInteger(inputs[i], end, isDigitOrLetter, actual) == 0);
+      CHECK(actual.isNull());
+    }
+  }
+}
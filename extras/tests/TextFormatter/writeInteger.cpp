@@ -53,3 +53,29 @@ TEST_CASE("uint32_t") {
   checkWriteInteger<uint32_t>(0, "0");
   checkWriteInteger<uint32_t>(4294967295U, "4294967295");
 }
+
+TEST_CASE("int64_t") {
+  checkWriteInteger<int64_t>(0, "0");
+  checkWriteInteger<int64_t>(int64_t(uint64_t(1) << 63),
+                             "-9223372036854775808");
+  checkWriteInteger<int64_t>(int64_t(~(uint64_t(1) << 63)),
+                             "9223372036854775807");
+}
+
+TEST_CASE("uint64_t") {
+  checkWriteInteger<uint64_t>(0, "0");
+  checkWriteInteger<uint64_t>(uint64_t(-1), "18446744073709551615");
+}
+
+TEST_CASE("Every number of digits") {
+  std::string ones = "1", nines = "9";
+  uint64_t one = 1, nine = 9;
+  for (int i = 1; i < 20; i++) {
+    checkWriteInteger<uint64_t>(one, ones);
+    checkWriteInteger<uint64_t>(nine, nines);
+    one = one * 10;
+    nine = nine * 10 + 9;
+    ones += "0";
+    nines += "9";
+  }
+}
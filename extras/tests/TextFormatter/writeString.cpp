@@ -5,7 +5,7 @@
 #include <catch.hpp>
 
 #include <ArduinoJson/Json/TextFormatter.hpp>
-#include <ArduinoJson/Serialization/Writers/StaticStringWriter.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
 
 using namespace ARDUINOJSON_NAMESPACE;
 
@@ -55,3 +55,45 @@ TEST_CASE("TextFormatter::writeString()") {
     check("\t", "\"\\t\"");
   }
 }
+
+TEST_CASE("TextFormatter::writeString(const char*, size_t)") {
+  std::string output;
+  Writer<std::string> sb(output);
+  TextFormatter<Writer<std::string> > writer(sb);
+
+  SECTION("Long strings with escaped characters") {
+    // crosses the SIMD blocks
+    std::string input, expected = "\"";
+    for (int i = 0; i < 100; i++) {
+      input += "abcdefghijklmnopqrstuvwxyz"[i % 26];
+      expected += "abcdefghijklmnopqrstuvwxyz"[i % 26];
+      if (i % 7 == 0) {
+        input += '"';
+        expected += "\\\"";
+      }
+      if (i % 11 == 0) {
+        input += '\\';
+        expected += "\\\\";
+      }
+    }
+    input += '\n';
+    expected += "\\n\"";
+
+    writer.writeString(input.c_str(), input.size());
+
+    REQUIRE(output == expected);
+    REQUIRE(writer.bytesWritten() == expected.size());
+  }
+
+  SECTION("Null character") {
+    writer.writeString("a\0b", 3);
+
+    REQUIRE(output == "\"a\\u0000b\"");
+  }
+
+  SECTION("Other control characters are not escaped") {
+    writer.writeString("\x01\x1F", 2);
+
+    REQUIRE(output == "\"\x01\x1F\"");
+  }
+}
@@ -26,12 +26,15 @@
 #include "ArduinoJson/Variant/VariantRef.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#include "ArduinoJson/Document/JsonImage.hpp"
+#include "ArduinoJson/Document/JsonSnapshot.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
 #include "ArduinoJson/Array/Utilities.hpp"
 #include "ArduinoJson/Collection/CollectionImpl.hpp"
+#include "ArduinoJson/Memory/MemoryPoolImpl.hpp"
 #include "ArduinoJson/Object/MemberProxy.hpp"
 #include "ArduinoJson/Object/ObjectImpl.hpp"
 #include "ArduinoJson/Variant/ConverterImpl.hpp"
@@ -39,8 +42,11 @@
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonLinesReader.hpp"
+#include "ArduinoJson/Json/JsonPullParser.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
+#include "ArduinoJson/Json/ResumableJsonDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
 
@@ -65,13 +71,25 @@ using ARDUINOJSON_NAMESPACE::DeserializationError;
 using ARDUINOJSON_NAMESPACE::deserializeJson;
 using ARDUINOJSON_NAMESPACE::deserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::DynamicJsonDocument;
+using ARDUINOJSON_NAMESPACE::estimateJsonCapacity;
 using ARDUINOJSON_NAMESPACE::JsonDocument;
+using ARDUINOJSON_NAMESPACE::JsonLinesReader;
+using ARDUINOJSON_NAMESPACE::JsonPullParser;
+using ARDUINOJSON_NAMESPACE::loadSnapshot;
 using ARDUINOJSON_NAMESPACE::measureJson;
+using ARDUINOJSON_NAMESPACE::measureSnapshot;
+using ARDUINOJSON_NAMESPACE::ResumableJsonDeserializer;
+using ARDUINOJSON_NAMESPACE::saveSnapshot;
 using ARDUINOJSON_NAMESPACE::serialized;
 using ARDUINOJSON_NAMESPACE::serializeJson;
 using ARDUINOJSON_NAMESPACE::serializeJsonPretty;
 using ARDUINOJSON_NAMESPACE::serializeMsgPack;
 using ARDUINOJSON_NAMESPACE::StaticJsonDocument;
+#if ARDUINOJSON_COMPACT_SLOTS && !ARDUINOJSON_ENABLE_COLLECTION_INDEX
+using ARDUINOJSON_NAMESPACE::measureJsonImage;
+using ARDUINOJSON_NAMESPACE::saveJsonImage;
+using ARDUINOJSON_NAMESPACE::viewJsonImage;
+#endif
 
 namespace DeserializationOption {
 using ARDUINOJSON_NAMESPACE::Filter;
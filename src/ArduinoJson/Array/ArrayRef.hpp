@@ -155,17 +155,18 @@ class ArrayRef : public ArrayRefBase<CollectionData>,
   FORCE_INLINE void remove(iterator it) const {
     if (!_data)
       return;
-    _data->removeSlot(it.internal());
+    _data->removeSlot(it.internal(), _pool);
   }
 
   // Removes element at specified index.
   FORCE_INLINE void remove(size_t index) const {
     if (!_data)
       return;
-    _data->removeElement(index);
+    _data->removeElement(index, _pool);
   }
 
   void clear() const {
+    ARDUINOJSON_ASSERT(!_pool || !_pool->frozen());
     if (!_data)
       return;
     _data->clear();
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <ArduinoJson/Collection/CollectionIndex.hpp>
+#include <ArduinoJson/Memory/CompactPointer.hpp>
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 
@@ -14,10 +16,17 @@ namespace ARDUINOJSON_NAMESPACE {
 class MemoryPool;
 class VariantData;
 class VariantSlot;
+struct MovedSlots;
 
 class CollectionData {
-  VariantSlot *_head;
-  VariantSlot *_tail;
+  CompactPointer<VariantSlot> _head;
+  CompactPointer<VariantSlot> _tail;
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  CollectionIndex *_index;  // only for large collections, may be null
+#endif
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_t _size;
+#endif
 
  public:
   // Must be a POD!
@@ -34,7 +43,7 @@ class CollectionData {
 
   VariantData *getOrAddElement(size_t index, MemoryPool *pool);
 
-  void removeElement(size_t index);
+  void removeElement(size_t index, MemoryPool *pool);
 
   // Object only
 
@@ -49,8 +58,8 @@ class CollectionData {
                               TStoragePolicy);
 
   template <typename TAdaptedString>
-  void removeMember(TAdaptedString key) {
-    removeSlot(getSlot(key));
+  void removeMember(TAdaptedString key, MemoryPool *pool) {
+    removeSlot(getSlot(key), pool);
   }
 
   template <typename TAdaptedString>
@@ -63,16 +72,40 @@ class CollectionData {
   size_t size() const;
 
   VariantSlot *addSlot(MemoryPool *);
-  void removeSlot(VariantSlot *slot);
+
+  // Gets the number of bytes that a collection of `size` slots takes in the
+  // pool, when they are added one after the other
+  static size_t estimateMemoryUsage(size_t size, bool isObject);
+  void removeSlot(VariantSlot *slot, MemoryPool *pool);
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  void release(MemoryPool *pool);
+#endif
 
   bool copyFrom(const CollectionData &src, MemoryPool *pool);
 
   VariantSlot *head() const {
-    return _head;
+    return _head.get();
   }
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
 
+  // Used by MemoryPool::compact()
+  size_t markSlots(const MemoryPool *pool);
+  void forwardSlots(const MovedSlots &moved);
+  template <typename TFunc>
+  void relocateStrings(TFunc &f, const MemoryPool *pool);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  void rebuildIndexes(MemoryPool *pool, bool hashed);
+
+  // Used by JsonDocument::freeze()
+  void completeIndexes(MemoryPool *pool, bool hashed);
+#endif
+
+  void relocate(ptrdiff_t distance) {
+    _head.move(0, distance);
+    _tail.move(0, distance);
+  }
+
  private:
   VariantSlot *getSlot(size_t index) const;
 
@@ -80,6 +113,18 @@ class CollectionData {
   VariantSlot *getSlot(TAdaptedString key) const;
 
   VariantSlot *getPreviousSlot(VariantSlot *) const;
+
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  template <typename TAdaptedString>
+  VariantSlot *findInIndex(TAdaptedString key) const;
+  static size_t initialIndexCapacity(bool hashed);
+  static size_t indexCapacity(size_t count, bool hashed);
+  void updateIndex(MemoryPool *pool);
+  void buildIndex(MemoryPool *pool, size_t capacity, bool hashed);
+  void insertInIndex(VariantSlot *slot);
+  void removeFromIndex(VariantSlot *slot, VariantSlot *prev);
+  void removeFromList(VariantSlot *slot, VariantSlot *prev);
+#endif
 };
 
 inline const VariantData *collectionToVariant(
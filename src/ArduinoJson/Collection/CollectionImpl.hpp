@@ -12,20 +12,27 @@
 namespace ARDUINOJSON_NAMESPACE {
 
 inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  updateIndex(pool);
+#endif
+
   VariantSlot* slot = pool->allocVariant();
   if (!slot)
     return 0;
 
-  if (_tail) {
-    ARDUINOJSON_ASSERT(pool->owns(_tail));  // Can't alter a linked array/object
-    _tail->setNextNotNull(slot);
-    _tail = slot;
+  VariantSlot* tail = _tail.get();
+  if (tail) {
+    ARDUINOJSON_ASSERT(pool->owns(tail));  // Can't alter a linked array/object
+    tail->setNextNotNull(slot);
   } else {
-    _head = slot;
-    _tail = slot;
+    _head.set(slot);
   }
+  _tail.set(slot);
 
   slot->clear();
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size++;
+#endif
   return slot;
 }
 
@@ -39,15 +46,21 @@ inline VariantData* CollectionData::addMember(TAdaptedString key,
                                               TStoragePolicy storage) {
   VariantSlot* slot = addSlot(pool);
   if (!slotSetKey(slot, key, pool, storage)) {
-    removeSlot(slot);
+    removeSlot(slot, pool);
     return 0;
   }
   return slot->data();
 }
 
 inline void CollectionData::clear() {
-  _head = 0;
-  _tail = 0;
+  _head.set(0);
+  _tail.set(0);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  _index = 0;
+#endif
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size = 0;
+#endif
 }
 
 template <typename TAdaptedString>
@@ -58,7 +71,7 @@ inline bool CollectionData::containsKey(const TAdaptedString& key) const {
 inline bool CollectionData::copyFrom(const CollectionData& src,
                                      MemoryPool* pool) {
   clear();
-  for (VariantSlot* s = src._head; s; s = s->next()) {
+  for (VariantSlot* s = src._head.get(); s; s = s->next()) {
     VariantData* var;
     if (s->key() != 0) {
       String key(s->key(), s->ownsKey() ? String::Copied : String::Linked);
@@ -78,7 +91,16 @@ template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
   if (key.isNull())
     return 0;
-  VariantSlot* slot = _head;
+  VariantSlot* slot = _head.get();
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index) {
+    VariantSlot* found = findInIndex(key);
+    if (found)
+      return found;
+    // the last slots may not be indexed yet
+    slot = _index->last ? _index->last->next() : _head.get();
+  }
+#endif
   while (slot) {
     if (stringEquals(key, adaptString(slot->key())))
       break;
@@ -88,13 +110,23 @@ inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
 }
 
 inline VariantSlot* CollectionData::getSlot(size_t index) const {
-  if (!_head)
+  VariantSlot* head = _head.get();
+  if (!head)
     return 0;
-  return _head->next(index);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index && !_index->hashed) {
+    if (index < _index->count)
+      return _index->buckets[index];
+    // the last slots may not be indexed yet
+    if (_index->last)
+      return _index->last->next(index - _index->count + 1);
+  }
+#endif
+  return head->next(index);
 }
 
 inline VariantSlot* CollectionData::getPreviousSlot(VariantSlot* target) const {
-  VariantSlot* current = _head;
+  VariantSlot* current = _head.get();
   while (current) {
     VariantSlot* next = current->next();
     if (next == target)
@@ -132,40 +164,62 @@ inline VariantData* CollectionData::getElement(size_t index) const {
 
 inline VariantData* CollectionData::getOrAddElement(size_t index,
                                                     MemoryPool* pool) {
-  VariantSlot* slot = _head;
-  while (slot && index > 0) {
-    slot = slot->next();
-    index--;
-  }
-  if (!slot)
-    index++;
-  while (index > 0) {
-    slot = addSlot(pool);
-    index--;
+  VariantSlot* slot = getSlot(index);
+  if (!slot) {
+    for (size_t n = size(); n <= index; n++)
+      slot = addSlot(pool);
   }
   return slotData(slot);
 }
 
-inline void CollectionData::removeSlot(VariantSlot* slot) {
+inline void CollectionData::removeSlot(VariantSlot* slot, MemoryPool* pool) {
+  ARDUINOJSON_ASSERT(!pool->frozen());
   if (!slot)
     return;
   VariantSlot* prev = getPreviousSlot(slot);
   VariantSlot* next = slot->next();
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index)
+    removeFromIndex(slot, prev);
+#endif
   if (prev)
     prev->setNext(next);
   else
-    _head = next;
+    _head.set(next);
   if (!next)
-    _tail = prev;
+    _tail.set(prev);
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size--;
+#endif
+  pool->freeVariant(slot);  // no-op without ARDUINOJSON_ENABLE_FREE_LISTS
 }
 
-inline void CollectionData::removeElement(size_t index) {
-  removeSlot(getSlot(index));
+inline void CollectionData::removeElement(size_t index, MemoryPool* pool) {
+  removeSlot(getSlot(index), pool);
 }
 
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+// Gives the slots and the table back to the pool; the next of each slot
+// remains, so an iterator can move past a removed slot
+inline void CollectionData::release(MemoryPool* pool) {
+  VariantSlot* slot = _head.get();
+  if (slot && !pool->owns(slot))  // shallow copy of another document
+    return;
+#  if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index)
+    pool->freeIndex(_index, CollectionIndex::sizeFor(_index->capacity));
+#  endif
+  while (slot) {
+    VariantSlot* next = slot->next();
+    pool->freeVariant(slot);
+    slot = next;
+  }
+}
+#endif
+
 inline size_t CollectionData::memoryUsage() const {
   size_t total = 0;
-  for (VariantSlot* s = _head; s; s = s->next()) {
+  for (VariantSlot* s = _head.get(); s; s = s->next()) {
     total += sizeof(VariantSlot) + s->data()->memoryUsage();
     if (s->ownsKey())
       total += strlen(s->key()) + 1;
@@ -173,8 +227,32 @@ inline size_t CollectionData::memoryUsage() const {
   return total;
 }
 
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+inline size_t CollectionData::estimateMemoryUsage(size_t size, bool isObject) {
+  size_t total = size * sizeof(VariantSlot);
+  // Same steps as updateIndex(): the table is built when the slot after the
+  // threshold is added, and doubled when it can't hold the previous slots
+  if (size <= ARDUINOJSON_COLLECTION_INDEX_THRESHOLD)
+    return total;
+  for (size_t capacity = initialIndexCapacity(isObject);; capacity *= 2) {
+    total += MemoryPool::indexSize(CollectionIndex::sizeFor(capacity));
+    size_t maxCount = isObject ? capacity / 2 : capacity;
+    if (size - 1 <= maxCount)
+      return total;
+  }
+}
+#else
+inline size_t CollectionData::estimateMemoryUsage(size_t size, bool) {
+  return size * sizeof(VariantSlot);
+}
+#endif
+
 inline size_t CollectionData::size() const {
-  return slotSize(_head);
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  return _size;
+#else
+  return slotSize(_head.get());
+#endif
 }
 
 template <typename T>
@@ -188,10 +266,272 @@ inline void movePointer(T*& p, ptrdiff_t offset) {
 
 inline void CollectionData::movePointers(ptrdiff_t stringDistance,
                                          ptrdiff_t variantDistance) {
-  movePointer(_head, variantDistance);
-  movePointer(_tail, variantDistance);
-  for (VariantSlot* slot = _head; slot; slot = slot->next())
+  _head.move(variantDistance, variantDistance);
+  _tail.move(variantDistance, variantDistance);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index) {
+    movePointer(_index, variantDistance);
+    movePointer(_index->last, variantDistance);
+    for (size_t i = 0; i < _index->capacity; i++)
+      movePointer(_index->buckets[i], variantDistance);
+  }
+#endif
+  for (VariantSlot* slot = _head.get(); slot; slot = slot->next())
     slot->movePointers(stringDistance, variantDistance);
 }
 
+// Marks the slots of the pool, and returns how many were not marked yet.
+// The tables of ARDUINOJSON_ENABLE_COLLECTION_INDEX are in the way, so they
+// are dropped, and rebuilt by rebuildIndexes().
+inline size_t CollectionData::markSlots(const MemoryPool* pool) {
+  VariantSlot* head = _head.get();
+  if (head && !pool->owns(head))  // shallow copy of another document
+    return 0;
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  _index = 0;  // even if empty, as the index may remain
+#endif
+  size_t count = 0;
+  for (VariantSlot* slot = head; slot; slot = slot->next()) {
+    if (slot->isMarked())  // shallow copy of another collection
+      continue;
+    slot->mark();
+    count += 1 + slot->data()->markSlots(pool);
+  }
+  return count;
+}
+
+// Fixes the links to the slots that moved, and unmarks the slots
+inline void CollectionData::forwardSlots(const MovedSlots& moved) {
+  VariantSlot* oldAddress = _head.get();
+  _head.set(moved.forward(oldAddress));
+  _tail.set(moved.forward(_tail.get()));
+  // an unmarked slot is already fixed, like the ones that follow it
+  VariantSlot* slot = _head.get();
+  while (slot && slot->isMarked()) {
+    slot->unmark();
+    VariantSlot* oldNext = slot->forwardNext(oldAddress, moved);
+    slot->data()->forwardSlots(moved);
+    oldAddress = oldNext;
+    slot = moved.forward(oldNext);
+  }
+}
+
+// Marks the visited slots, so a slot shared by a shallow copy is visited once
+template <typename TFunc>
+inline void CollectionData::relocateStrings(TFunc& f, const MemoryPool* pool) {
+  VariantSlot* head = _head.get();
+  if (!head || !pool->owns(head))  // shallow copy of another document
+    return;
+  for (VariantSlot* slot = head; slot; slot = slot->next()) {
+    if (slot->isMarked())
+      continue;
+    slot->mark();
+    slot->relocateStrings(f, pool);
+  }
+}
+
+template <typename TFunc>
+inline void VariantSlot::relocateStrings(TFunc& f, const MemoryPool* pool) {
+  if (_flags & OWNED_KEY_BIT) {
+    const char* k = _key.get();
+    _key.set(f(k, strlen(k)));
+  }
+  data()->relocateStrings(f, pool);
+}
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+inline void VariantSlot::release(MemoryPool* pool) {
+#  if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  if (_flags & OWNED_KEY_BIT) {
+    const char* k = _key.get();
+    pool->freeString(k, strlen(k) + 1);
+  }
+#  endif
+  data()->release(pool);
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+inline void CollectionData::rebuildIndexes(MemoryPool* pool, bool hashed) {
+  VariantSlot* head = _head.get();
+  if (!head || !pool->owns(head))  // shallow copy of another document
+    return;
+  size_t count = 0;
+  for (VariantSlot* slot = head; slot; slot = slot->next()) {
+    slot->data()->rebuildIndexes(pool);
+    count++;
+  }
+  if (count < ARDUINOJSON_COLLECTION_INDEX_THRESHOLD)
+    return;
+  buildIndex(pool, indexCapacity(count, hashed), hashed);
+}
+
+// Adds the slots that updateIndex() didn't see yet, in this collection and in
+// the nested ones, so the lookups never need to, and the tables that
+// couldn't be created (or grown) when the collection reached their size
+inline void CollectionData::completeIndexes(MemoryPool* pool, bool hashed) {
+  VariantSlot* head = _head.get();
+  if (!head || !pool->owns(head))  // shallow copy of another document
+    return;
+  size_t count = 0;
+  for (VariantSlot* slot = head; slot; slot = slot->next()) {
+    slot->data()->completeIndexes(pool);
+    count++;
+  }
+  if (_index)
+    updateIndex(pool);  // grows the table if needed
+  bool complete = _index && _index->last == _tail.get();
+  if (!complete && count >= ARDUINOJSON_COLLECTION_INDEX_THRESHOLD)
+    buildIndex(pool, indexCapacity(count, hashed), hashed);
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+template <typename TAdaptedString>
+inline VariantSlot* CollectionData::findInIndex(TAdaptedString key) const {
+  size_t mask = _index->capacity - 1;
+  for (size_t i = stringHash(key) & mask;; i = (i + 1) & mask) {
+    VariantSlot* slot = _index->buckets[i];
+    if (!slot || stringEquals(key, adaptString(slot->key())))
+      return slot;
+  }
+}
+
+inline size_t CollectionData::initialIndexCapacity(bool hashed) {
+  // a hash table is never more than half full, and the probes need a power of
+  // two, whatever the threshold
+  size_t capacity = 1;
+  while (capacity < (hashed ? 4 : 2) * ARDUINOJSON_COLLECTION_INDEX_THRESHOLD)
+    capacity *= 2;
+  return capacity;
+}
+
+// Gets the capacity of a table for `count` slots, with room for one more
+inline size_t CollectionData::indexCapacity(size_t count, bool hashed) {
+  size_t capacity = initialIndexCapacity(hashed);
+  while ((hashed ? 2 * (count + 1) : count + 1) > capacity)
+    capacity *= 2;
+  return capacity;
+}
+
+// Adds the slots that were added since the last call (for an object, only
+// once they have a key), and creates the table when the collection reaches the
+// threshold
+inline void CollectionData::updateIndex(MemoryPool* pool) {
+  VariantSlot* tail = _tail.get();
+  if (!tail)
+    return;
+
+  if (!_index) {
+    // Only try once, so a full pool doesn't cost a rebuild for every slot
+    if (_head.get()->next(ARDUINOJSON_COLLECTION_INDEX_THRESHOLD - 1) == tail) {
+      // The members of an object get their key right after addSlot()
+      bool hashed = tail->key() != 0;
+      buildIndex(pool, initialIndexCapacity(hashed), hashed);
+    }
+    return;
+  }
+
+  VariantSlot* slot = _index->last ? _index->last->next() : _head.get();
+  for (; slot; slot = slot->next()) {
+    if (_index->isFull())
+      return buildIndex(pool, 2 * _index->capacity, _index->hashed);
+    insertInIndex(slot);
+  }
+}
+
+// Replaces the table with a larger one.
+// The old table stays in the pool, like the removed slots, so the waste is
+// bounded by the size of the last table (with ARDUINOJSON_ENABLE_FREE_LISTS,
+// its cells become free slots).
+inline void CollectionData::buildIndex(MemoryPool* pool, size_t capacity,
+                                       bool hashed) {
+  void* p = pool->allocIndex(CollectionIndex::sizeFor(capacity));
+  if (!p)  // keep the old table, if any
+    return;
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  if (_index)
+    pool->freeIndex(_index, CollectionIndex::sizeFor(_index->capacity));
+#endif
+  _index = static_cast<CollectionIndex*>(p);
+  _index->last = 0;
+  _index->count = 0;
+  _index->capacity = capacity;
+  _index->hashed = hashed;
+  for (size_t i = 0; i < capacity; i++)
+    _index->buckets[i] = 0;
+  for (VariantSlot* slot = _head.get(); slot; slot = slot->next()) {
+    if (_index->isFull())  // the next call to updateIndex() will grow it
+      break;
+    insertInIndex(slot);
+  }
+}
+
+inline void CollectionData::insertInIndex(VariantSlot* slot) {
+  ARDUINOJSON_ASSERT(!_index->isFull());
+  _index->last = slot;
+  if (!_index->hashed) {
+    _index->buckets[_index->count++] = slot;
+    return;
+  }
+  size_t mask = _index->capacity - 1;
+  size_t i = stringHash(adaptString(slot->key())) & mask;
+  while (_index->buckets[i])
+    i = (i + 1) & mask;
+  _index->buckets[i] = slot;
+  _index->count++;
+}
+
+// Removes the entry in place, so the table remains usable: we can't free it
+// and build another one every time a member is removed
+inline void CollectionData::removeFromIndex(VariantSlot* slot,
+                                            VariantSlot* prev) {
+  if (!_index->hashed)
+    return removeFromList(slot, prev);
+
+  if (!slot->key())  // addMember() failed to set the key
+    return;
+
+  size_t mask = _index->capacity - 1;
+  size_t i = stringHash(adaptString(slot->key())) & mask;
+  while (_index->buckets[i] != slot) {
+    if (!_index->buckets[i])  // not indexed yet
+      return;
+    i = (i + 1) & mask;
+  }
+
+  if (_index->last == slot)
+    _index->last = prev;
+  _index->count--;
+
+  // Shift back the following entries that would no longer be reachable
+  // (Knuth's algorithm R)
+  for (size_t j = (i + 1) & mask; _index->buckets[j]; j = (j + 1) & mask) {
+    size_t k = stringHash(adaptString(_index->buckets[j]->key())) & mask;
+    bool reachable = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if (!reachable) {
+      _index->buckets[i] = _index->buckets[j];
+      i = j;
+    }
+  }
+  _index->buckets[i] = 0;
+}
+
+inline void CollectionData::removeFromList(VariantSlot* slot,
+                                           VariantSlot* prev) {
+  size_t i = 0;
+  while (i < _index->count && _index->buckets[i] != slot)
+    i++;
+  if (i == _index->count)  // not indexed yet
+    return;
+
+  if (_index->last == slot)
+    _index->last = prev;
+  _index->count--;
+  for (; i < _index->count; i++)
+    _index->buckets[i] = _index->buckets[i + 1];
+  _index->buckets[i] = 0;
+}
+#endif
+
 }  // namespace ARDUINOJSON_NAMESPACE
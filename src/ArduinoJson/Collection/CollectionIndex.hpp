@@ -0,0 +1,43 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+class VariantSlot;
+
+// A table of the slots of a large collection, allocated in the MemoryPool.
+// For an object, it's a hash table of the members, with open addressing and
+// linear probing, that is never more than half full. For an array, it's the
+// list of elements, in order.
+// It covers the slots from the head to `last`; the slots added after that are
+// searched linearly.
+struct CollectionIndex {
+  VariantSlot *last;
+  size_t count;     // number of slots in the table
+  size_t capacity;  // number of buckets, a power of two
+  bool hashed;      // true for an object, false for an array
+  VariantSlot *buckets[1];
+
+  // Must be a POD!
+  // - no constructor
+  // - no destructor
+  // - no virtual
+  // - no inheritance
+
+  static size_t sizeFor(size_t capacity) {
+    return sizeof(CollectionIndex) + (capacity - 1) * sizeof(VariantSlot *);
+  }
+
+  bool isFull() const {
+    return (hashed ? 2 * (count + 1) : count + 1) > capacity;
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
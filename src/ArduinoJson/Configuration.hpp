@@ -81,6 +81,19 @@
 #  define ARDUINOJSON_USE_DOUBLE 1
 #endif
 
+// Parse double values with the Eisel-Lemire algorithm, which is faster and
+// correctly rounded, but needs a 10 KB table
+#ifndef ARDUINOJSON_FAST_FLOAT
+#  define ARDUINOJSON_FAST_FLOAT 0
+#endif
+
+// Serialize double values with the fewest digits that parse back to the same
+// value (Schubfach algorithm), which is faster and exact, but needs the same
+// 10 KB table as ARDUINOJSON_FAST_FLOAT
+#ifndef ARDUINOJSON_SHORTEST_FLOAT
+#  define ARDUINOJSON_SHORTEST_FLOAT 0
+#endif
+
 // Store integral values with long (0) or long long (1)
 #ifndef ARDUINOJSON_USE_LONG_LONG
 #  if ARDUINOJSON_HAS_LONG_LONG && defined(__SIZEOF_POINTER__) && \
@@ -202,6 +215,16 @@
 #  endif
 #endif
 
+// Use SIMD instructions (SSE2, AVX2, or NEON) to scan in-memory inputs
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__ARM_NEON)
+#    define ARDUINOJSON_ENABLE_SIMD 1
+#  else
+#    define ARDUINOJSON_ENABLE_SIMD 0
+#  endif
+#endif
+
 #ifndef ARDUINOJSON_ENABLE_ALIGNMENT
 #  if defined(__AVR)
 #    define ARDUINOJSON_ENABLE_ALIGNMENT 0
@@ -218,6 +241,62 @@
 #  define ARDUINOJSON_ENABLE_STRING_DEDUPLICATION 1
 #endif
 
+// Let BasicJsonDocument allocate extra blocks when the pool is full, instead
+// of failing with NoMemory; the capacity becomes the size of the first block
+// (at least 184 bytes on 64-bit hosts). The extra blocks have the same size,
+// and their variants must be within reach of the others (see
+// ARDUINOJSON_SLOT_OFFSET_SIZE); a block that the allocator puts further away
+// only gets strings, and the document overflows if the next one is too.
+#ifndef ARDUINOJSON_ENABLE_POOL_GROWTH
+#  define ARDUINOJSON_ENABLE_POOL_GROWTH 0
+#endif
+
+// Build a hash table in the memory pool to find duplicate strings in constant
+// time, once the pool contains many strings (costs two words per document,
+// plus the table). Requires ARDUINOJSON_ENABLE_STRING_DEDUPLICATION.
+#ifndef ARDUINOJSON_ENABLE_STRING_TABLE
+#  define ARDUINOJSON_ENABLE_STRING_TABLE 0
+#endif
+
+// Build a table in the memory pool to find the members of large objects and
+// the elements of large arrays in constant time (costs one pointer per
+// collection, plus the tables)
+#ifndef ARDUINOJSON_ENABLE_COLLECTION_INDEX
+#  define ARDUINOJSON_ENABLE_COLLECTION_INDEX 0
+#endif
+
+// Number of members or elements from which a collection gets a table
+#ifndef ARDUINOJSON_COLLECTION_INDEX_THRESHOLD
+#  define ARDUINOJSON_COLLECTION_INDEX_THRESHOLD 16
+#endif
+
+// Store the number of elements of arrays and objects, so size() doesn't walk
+// the list (costs one size_t per collection)
+#ifndef ARDUINOJSON_CACHE_COLLECTION_SIZE
+#  define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#endif
+
+// Store the pointers of the variants as 32-bit offsets in the memory pool, so
+// a VariantSlot takes 16 bytes instead of 32 on 64-bit hosts. The strings are
+// always copied, shallowCopy() makes a copy, and the capacity is limited to
+// 2 GB, including 128 MB of variants.
+#ifndef ARDUINOJSON_COMPACT_SLOTS
+#  define ARDUINOJSON_COMPACT_SLOTS 0
+#endif
+
+#if ARDUINOJSON_COMPACT_SLOTS && ARDUINOJSON_ENABLE_POOL_GROWTH
+#  error ARDUINOJSON_COMPACT_SLOTS requires ARDUINOJSON_ENABLE_POOL_GROWTH == 0
+#endif
+
+// Keep the slots of the removed values in a list, so the next values can use
+// them again (costs one pointer per document). If
+// ARDUINOJSON_ENABLE_STRING_DEDUPLICATION is 0, keep the removed and replaced
+// strings in lists by size too (costs 11 more pointers); otherwise, they may
+// be shared. A removed value must not be referenced by shallowCopy().
+#ifndef ARDUINOJSON_ENABLE_FREE_LISTS
+#  define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#endif
+
 #ifndef ARDUINOJSON_STRING_BUFFER_SIZE
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
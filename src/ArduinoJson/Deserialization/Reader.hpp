@@ -54,3 +54,7 @@ struct BoundedReader {
 #if ARDUINOJSON_ENABLE_STD_STREAM
 #  include <ArduinoJson/Deserialization/Readers/StdStreamReader.hpp>
 #endif
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+#  include <ArduinoJson/Deserialization/Readers/StdStringReader.hpp>
+#endif
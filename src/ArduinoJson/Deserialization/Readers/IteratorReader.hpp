@@ -26,6 +26,15 @@ class IteratorReader {
     while (i < length && _ptr < _end) buffer[i++] = *_ptr++;
     return i;
   }
+
+  // Position of the next character to read
+  TIterator ptr() const {
+    return _ptr;
+  }
+
+  TIterator end() const {
+    return _end;
+  }
 };
 
 template <typename T>
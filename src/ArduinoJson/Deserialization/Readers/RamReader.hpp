@@ -35,6 +35,11 @@ struct Reader<TSource*,
     for (size_t i = 0; i < length; i++) buffer[i] = *_ptr++;
     return length;
   }
+
+  // Position of the next character to read
+  const char* ptr() const {
+    return _ptr;
+  }
 };
 
 template <typename TSource>
@@ -47,4 +52,29 @@ struct BoundedReader<TSource*,
                                     reinterpret_cast<const char*>(ptr) + len) {}
 };
 
+// Tells whether a reader gives access to a contiguous buffer in RAM, which
+// allows JsonDeserializer to scan the input in bulk.
+template <typename TReader, typename Enable = void>
+struct IsRamReader : false_type {};
+
+template <typename TSource>
+struct IsRamReader<Reader<TSource*>,
+                   typename enable_if<IsCharOrVoid<TSource>::value>::type>
+    : true_type {};
+
+template <typename TReader>
+struct IsRamReader<TReader, typename enable_if<is_base_of<
+                                IteratorReader<const char*>, TReader>::value>::type>
+    : true_type {};
+
+// Tells whether a RamReader has no end but the terminator, which must be
+// found while reading
+template <typename TReader, typename Enable = void>
+struct IsNullTerminatedReader : false_type {};
+
+template <typename TSource>
+struct IsNullTerminatedReader<
+    Reader<TSource*>, typename enable_if<IsCharOrVoid<TSource>::value>::type>
+    : true_type {};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,19 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <string>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// std::string's storage is contiguous, so we read it with a pointer rather
+// than with the generic IteratorReader<std::string::const_iterator>
+template <>
+struct Reader<std::string, void> : BoundedReader<const char*> {
+  explicit Reader(const std::string& s)
+      : BoundedReader<const char*>(s.data(), s.size()) {}
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
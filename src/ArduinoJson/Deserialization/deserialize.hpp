@@ -68,4 +68,32 @@ DeserializationError deserialize(JsonDocument &doc, TStream &input,
       .parse(doc.data(), filter, nestingLimit);
 }
 
+// estimateCapacity(const std::string&, NestingLimit);
+// estimateCapacity(const String&, NestingLimit);
+// estimateCapacity(char*, NestingLimit);
+// estimateCapacity(const char*, NestingLimit);
+// estimateCapacity(const __FlashStringHelper*, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TString>
+typename enable_if<!is_array<TString>::value, size_t>::type estimateCapacity(
+    const TString &input, NestingLimit nestingLimit) {
+  Reader<TString> reader(input);
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(
+             pool, reader, StringCounter(makeStringStorage(input, pool)))
+      .estimateCapacity(nestingLimit);
+}
+//
+// estimateCapacity(char*, size_t, NestingLimit);
+// estimateCapacity(const char*, size_t, NestingLimit);
+// estimateCapacity(const __FlashStringHelper*, size_t, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TChar>
+size_t estimateCapacity(TChar *input, size_t inputSize,
+                        NestingLimit nestingLimit) {
+  BoundedReader<TChar *> reader(input, inputSize);
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(
+             pool, reader, StringCounter(makeStringStorage(input, pool)))
+      .estimateCapacity(nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
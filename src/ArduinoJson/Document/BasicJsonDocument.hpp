@@ -105,21 +105,27 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   void shrinkToFit() {
+    // Only a single block can be reallocated
+    if (_pool.hasExtraBlocks() && !garbageCollect())
+      return;
+
     ptrdiff_t bytes_reclaimed = _pool.squash();
     if (bytes_reclaimed == 0)
       return;
 
     void* old_ptr = _pool.buffer();
-    void* new_ptr = this->reallocate(old_ptr, _pool.capacity());
+    void* new_ptr =
+        this->reallocate(old_ptr, MemoryPool::bufferSize(_pool.capacity()));
 
     ptrdiff_t ptr_offset =
         static_cast<char*>(new_ptr) - static_cast<char*>(old_ptr);
 
     _pool.movePointers(ptr_offset);
-    _data.movePointers(ptr_offset, ptr_offset - bytes_reclaimed);
+    data().movePointers(ptr_offset, ptr_offset - bytes_reclaimed);
   }
 
   bool garbageCollect() {
+    ARDUINOJSON_ASSERT(!_pool.frozen());
     // make a temporary clone and move assign
     BasicJsonDocument tmp(*this);
     if (!tmp.capacity())
@@ -132,25 +138,57 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   using AllocatorOwner<TAllocator>::allocator;
 
  private:
+  static size_t poolCapacity(size_t requiredSize) {
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    requiredSize = MemoryPool::growableCapacity(requiredSize);
+#endif
+    return addPadding(requiredSize);
+  }
+
   MemoryPool allocPool(size_t requiredSize) {
-    size_t capa = addPadding(requiredSize);
-    return MemoryPool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+    size_t size = MemoryPool::bufferSize(poolCapacity(requiredSize));
+    MemoryPool pool(reinterpret_cast<char*>(this->allocate(size)), size);
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    pool.setAllocator(blockAllocator());
+#endif
+    return pool;
+  }
+
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  BlockAllocator blockAllocator() {
+    BlockAllocator result = {allocateBlock, deallocateBlock,
+                             static_cast<AllocatorOwner<TAllocator>*>(this)};
+    return result;
   }
 
+  static void* allocateBlock(void* owner, size_t size) {
+    return static_cast<AllocatorOwner<TAllocator>*>(owner)->allocate(size);
+  }
+
+  static void deallocateBlock(void* owner, void* ptr) {
+    static_cast<AllocatorOwner<TAllocator>*>(owner)->deallocate(ptr);
+  }
+#endif
+
   void reallocPool(size_t requiredSize) {
-    size_t capa = addPadding(requiredSize);
+    size_t capa = poolCapacity(requiredSize);
     if (capa == _pool.capacity())
       return;
     freePool();
-    replacePool(allocPool(addPadding(requiredSize)));
+    replacePool(allocPool(capa));
   }
 
   void freePool() {
+    _pool.clear();  // releases the extra blocks
     this->deallocate(memoryPool().buffer());
   }
 
   void copyAssignFrom(const JsonDocument& src) {
     reallocPool(src.capacity());
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    // the pool may come from JsonDocument(), which has no allocator
+    _pool.setAllocator(blockAllocator());
+#endif
     set(src);
   }
 
@@ -158,6 +196,9 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     freePool();
     _data = src._data;
     _pool = src._pool;
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    _pool.setAllocator(blockAllocator());
+#endif
     src._data.setNull();
     src._pool = MemoryPool(0, 0);
   }
@@ -30,7 +30,33 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
 
   void clear() {
     _pool.clear();
-    _data.init();
+    data().init();
+  }
+
+  // Reclaims the memory of the removed values, by moving the others together,
+  // in place: unlike garbageCollect(), it doesn't need a second pool.
+  // Does nothing if the pool has extra blocks (ARDUINOJSON_ENABLE_POOL_GROWTH)
+  void compact() {
+    ARDUINOJSON_ASSERT(!_pool.frozen());
+    if (!_pool.hasExtraBlocks())
+      _pool.compact(data());
+  }
+
+  // Makes the document read-only, so several threads can read it at the same
+  // time: reading never modifies a document, but the lookup tables
+  // (ARDUINOJSON_ENABLE_COLLECTION_INDEX) catch up with the values lazily, so
+  // they are completed here.
+  // clear() makes the document writable again, once the readers are done.
+  void freeze() {
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+    if (!_pool.frozen())
+      data().completeIndexes(&_pool);
+#endif
+    _pool.freeze();
+  }
+
+  bool isFrozen() const {
+    return _pool.frozen();
   }
 
   template <typename T>
@@ -56,7 +82,7 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   size_t nesting() const {
-    return variantNesting(&_data);
+    return variantNesting(&data());
   }
 
   size_t capacity() const {
@@ -64,7 +90,7 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   size_t size() const {
-    return _data.size();
+    return data().size();
   }
 
   bool set(const JsonDocument& src) {
@@ -88,11 +114,26 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
     return _pool;
   }
 
+  // for internal use only
+  const MemoryPool& memoryPool() const {
+    return _pool;
+  }
+
   // for internal use only
   VariantData& data() {
+#if ARDUINOJSON_COMPACT_SLOTS
+    VariantSlot* root = _pool.root();
+    if (root)
+      return *root->data();
+#endif
     return _data;
   }
 
+  // for internal use only
+  const VariantData& data() const {
+    return const_cast<JsonDocument*>(this)->data();
+  }
+
   ArrayRef createNestedArray() {
     return add().to<ArrayRef>();
   }
@@ -136,14 +177,14 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   // containsKey(const __FlashStringHelper*) const
   template <typename TChar>
   bool containsKey(TChar* key) const {
-    return _data.getMember(adaptString(key)) != 0;
+    return data().getMember(adaptString(key)) != 0;
   }
 
   // containsKey(const std::string&) const
   // containsKey(const String&) const
   template <typename TString>
   bool containsKey(const TString& key) const {
-    return _data.getMember(adaptString(key)) != 0;
+    return data().getMember(adaptString(key)) != 0;
   }
 
   // operator[](const std::string&)
@@ -171,7 +212,7 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   FORCE_INLINE
       typename enable_if<IsString<TString>::value, VariantConstRef>::type
       operator[](const TString& key) const {
-    return VariantConstRef(_data.getMember(adaptString(key)));
+    return VariantConstRef(data().getMember(adaptString(key)));
   }
 
   // operator[](char*) const
@@ -181,7 +222,7 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   FORCE_INLINE
       typename enable_if<IsString<TChar*>::value, VariantConstRef>::type
       operator[](TChar* key) const {
-    return VariantConstRef(_data.getMember(adaptString(key)));
+    return VariantConstRef(data().getMember(adaptString(key)));
   }
 
   FORCE_INLINE ElementProxy<JsonDocument&> operator[](size_t index) {
@@ -189,11 +230,11 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   FORCE_INLINE VariantConstRef operator[](size_t index) const {
-    return VariantConstRef(_data.getElement(index));
+    return VariantConstRef(data().getElement(index));
   }
 
   FORCE_INLINE VariantRef add() {
-    return VariantRef(&_pool, _data.addElement(&_pool));
+    return VariantRef(&_pool, data().addElement(&_pool));
   }
 
   template <typename TValue>
@@ -210,7 +251,7 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   FORCE_INLINE void remove(size_t index) {
-    _data.remove(index);
+    data().remove(index, &_pool);
   }
   // remove(char*)
   // remove(const char*)
@@ -218,14 +259,14 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar*>::value>::type remove(
       TChar* key) {
-    _data.remove(adaptString(key));
+    data().remove(adaptString(key), &_pool);
   }
   // remove(const std::string&)
   // remove(const String&)
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString& key) {
-    _data.remove(adaptString(key));
+    data().remove(adaptString(key), &_pool);
   }
 
   FORCE_INLINE operator VariantRef() {
@@ -238,15 +279,15 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
 
  protected:
   JsonDocument() : _pool(0, 0) {
-    _data.init();
+    data().init();
   }
 
   JsonDocument(MemoryPool pool) : _pool(pool) {
-    _data.init();
+    data().init();
   }
 
   JsonDocument(char* buf, size_t capa) : _pool(buf, capa) {
-    _data.init();
+    data().init();
   }
 
   ~JsonDocument() {}
@@ -256,15 +297,15 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   VariantRef getVariant() {
-    return VariantRef(&_pool, &_data);
+    return VariantRef(&_pool, &data());
   }
 
   VariantConstRef getVariant() const {
-    return VariantConstRef(&_data);
+    return VariantConstRef(&data());
   }
 
   MemoryPool _pool;
-  VariantData _data;
+  VariantData _data;  // with ARDUINOJSON_COMPACT_SLOTS, only if no buffer
 
  private:
   JsonDocument(const JsonDocument&);
@@ -276,15 +317,15 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
   }
 
   VariantData* getData() {
-    return &_data;
+    return &data();
   }
 
   const VariantData* getData() const {
-    return &_data;
+    return &data();
   }
 
   VariantData* getOrCreateData() {
-    return &_data;
+    return &data();
   }
 };
 
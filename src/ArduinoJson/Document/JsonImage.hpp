@@ -0,0 +1,84 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonSnapshot.hpp>
+
+#include <stdint.h>  // uint32_t
+#include <string.h>  // memcpy, strncmp, strncpy
+
+// An image is a copy of the memory pool that contains only CompactPointers, so
+// it can be saved to a file, mapped back at another address, or shared
+// between processes, and read in place.
+// The tables of ARDUINOJSON_ENABLE_COLLECTION_INDEX contain absolute pointers.
+#if ARDUINOJSON_COMPACT_SLOTS && !ARDUINOJSON_ENABLE_COLLECTION_INDEX
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// +--------+-------------+-----------------+------+
+// | header | strings...  |  ...variants    | root |
+// +--------+-------------+-----------------+------+
+struct JsonImageHeader {
+  // The name of the namespace, which depends on the version and the settings
+  char signature[24];
+  // The size of the slots and the endianness, which the signature doesn't tell
+  uint32_t layout;
+  uint32_t size;
+};
+
+// Gets the number of bytes of the image of a document
+inline size_t measureJsonImage(const JsonDocument& doc) {
+  return sizeof(JsonImageHeader) + doc.memoryPool().squashedSize() +
+         rootVariantSize;
+}
+
+// Writes the image of a document in a buffer aligned like a pointer.
+// Returns the number of bytes written, or 0 if the buffer is too small.
+inline size_t saveJsonImage(const JsonDocument& doc, void* buffer,
+                            size_t bufferSize) {
+  size_t size = measureJsonImage(doc);
+  if (!buffer || bufferSize < size || !isAligned(buffer))
+    return 0;
+
+  char* image = static_cast<char*>(buffer);
+  JsonImageHeader* header = static_cast<JsonImageHeader*>(buffer);
+  memset(header, 0, sizeof(JsonImageHeader));
+  strncpy(header->signature, jsonSignature(), sizeof(header->signature));
+  header->layout = jsonSnapshotLayout();
+  header->size = uint32_t(size);
+
+  ptrdiff_t stringDistance, variantDistance;
+  doc.memoryPool().copySquashed(image + sizeof(JsonImageHeader),
+                                &stringDistance, &variantDistance);
+
+  // The root follows the variants, like in the pool
+  void* root = image + size - rootVariantSize;
+  memcpy(root, &doc.data(), rootVariantSize);
+  static_cast<VariantData*>(root)->movePointers(stringDistance,
+                                                variantDistance);
+  return size;
+}
+
+// Reads an image in place, without any change to the image.
+// Returns null if the image comes from another version, configuration, or
+// platform.
+inline VariantConstRef viewJsonImage(const void* image, size_t size) {
+  if (!image || size < sizeof(JsonImageHeader) + rootVariantSize ||
+      !isAligned(image))
+    return VariantConstRef(0);
+
+  const JsonImageHeader* header = static_cast<const JsonImageHeader*>(image);
+  if (strncmp(header->signature, jsonSignature(),
+              sizeof(header->signature)) != 0 ||
+      header->layout != jsonSnapshotLayout() || header->size != size)
+    return VariantConstRef(0);
+
+  const void* root = static_cast<const char*>(image) + size - rootVariantSize;
+  return VariantConstRef(static_cast<const VariantData*>(root));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif
@@ -0,0 +1,220 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Polyfills/preprocessor.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Variant/Visitor.hpp>
+
+#include <stdint.h>  // uint32_t, uintptr_t
+#include <string.h>  // memset, strncmp, strncpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A snapshot is a copy of the memory pool, which loads without parsing, but
+// only in a program with the same version, settings, and platform.
+//
+// +--------+-------------+--------------+------+
+// | header | strings...  |  ...variants | root |
+// +--------+-------------+--------------+------+
+struct JsonSnapshotHeader {
+  // The name of the namespace, which depends on the version and the settings
+  char signature[24];
+  uint32_t layout;
+  uint32_t stringsSize;
+  uint32_t variantsSize;
+  // The addresses of the strings and the variants in the saved document
+  uintptr_t strings;
+  uintptr_t variants;
+};
+
+inline const char* jsonSignature() {
+  return ARDUINOJSON_STRINGIFY_VALUE(ARDUINOJSON_NAMESPACE);
+}
+
+// Identifies the platform, which the signature doesn't
+inline uint32_t jsonSnapshotLayout() {
+  const uint16_t one = 1;
+  bool littleEndian = *reinterpret_cast<const uint8_t*>(&one) == 1;
+  return uint32_t(sizeof(VariantSlot) | sizeof(void*) << 8) |
+         (littleEndian ? 0x10000u : 0u);
+}
+
+// Finds the pointers that a snapshot can't restore: the linked strings, and
+// the values that come from another document
+class ForeignPointerFinder : public Visitor<bool> {
+ public:
+  ForeignPointerFinder(const MemoryPool& pool) : _pool(&pool) {}
+
+  bool visitArray(const CollectionData& array) {
+    return visitCollection(array);
+  }
+
+  bool visitObject(const CollectionData& object) {
+    return visitCollection(object);
+  }
+
+  bool visitRawJson(const char* p, size_t) {
+    return !_pool->owns(p);
+  }
+
+  bool visitString(const char* p, size_t) {
+    return !_pool->owns(p);
+  }
+
+ private:
+  bool visitCollection(const CollectionData& collection) {
+    for (const VariantSlot* slot = collection.head(); slot;
+         slot = slot->next()) {
+      if (!_pool->owns(slot))
+        return true;
+      if (slot->key() && !_pool->owns(slot->key()))
+        return true;
+      if (slot->data()->accept(*this))
+        return true;
+    }
+    return false;
+  }
+
+  const MemoryPool* _pool;
+};
+
+inline bool canSaveSnapshot(const JsonDocument& doc) {
+  const MemoryPool& pool = doc.memoryPool();
+  if (pool.hasExtraBlocks())
+    return false;
+  ForeignPointerFinder finder(pool);
+  return !doc.data().accept(finder);
+}
+
+template <typename TWriter>
+size_t doSaveSnapshot(const JsonDocument& doc, TWriter writer) {
+  if (!canSaveSnapshot(doc))
+    return 0;
+
+  const char *strings, *variants;
+  size_t stringsSize, variantsSize;
+  doc.memoryPool().getStrings(&strings, &stringsSize);
+  doc.memoryPool().getVariants(&variants, &variantsSize);
+
+  JsonSnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.signature, jsonSignature(), sizeof(header.signature));
+  header.layout = jsonSnapshotLayout();
+  header.stringsSize = uint32_t(stringsSize);
+  header.variantsSize = uint32_t(variantsSize);
+  if (header.stringsSize != stringsSize || header.variantsSize != variantsSize)
+    return 0;
+  header.strings = reinterpret_cast<uintptr_t>(strings);
+  header.variants = reinterpret_cast<uintptr_t>(variants);
+
+  size_t n = writer.write(reinterpret_cast<const uint8_t*>(&header),
+                          sizeof(header));
+  n += writer.write(reinterpret_cast<const uint8_t*>(strings), stringsSize);
+  n += writer.write(reinterpret_cast<const uint8_t*>(variants), variantsSize);
+  n += writer.write(reinterpret_cast<const uint8_t*>(&doc.data()),
+                    sizeof(VariantData));
+  return n;
+}
+
+// Gets the number of bytes of the snapshot of a document, or 0 if the
+// document contains linked strings or values of another document.
+inline size_t measureSnapshot(const JsonDocument& doc) {
+  if (!canSaveSnapshot(doc))
+    return 0;
+  const char* p;
+  size_t stringsSize, variantsSize;
+  doc.memoryPool().getStrings(&p, &stringsSize);
+  doc.memoryPool().getVariants(&p, &variantsSize);
+  return sizeof(JsonSnapshotHeader) + stringsSize + variantsSize +
+         sizeof(VariantData);
+}
+
+// saveSnapshot(const JsonDocument&, std::string&);
+// saveSnapshot(const JsonDocument&, std::ostream&);
+// saveSnapshot(const JsonDocument&, String&);
+// saveSnapshot(const JsonDocument&, Print&);
+template <typename TDestination>
+size_t saveSnapshot(const JsonDocument& doc, TDestination& destination) {
+  Writer<TDestination> writer(destination);
+  return doSaveSnapshot(doc, writer);
+}
+
+inline size_t saveSnapshot(const JsonDocument& doc, void* buffer,
+                           size_t bufferSize) {
+  StaticStringWriter writer(reinterpret_cast<char*>(buffer), bufferSize);
+  return doSaveSnapshot(doc, writer);
+}
+
+template <typename TReader>
+DeserializationError doLoadSnapshot(JsonDocument& doc, TReader reader) {
+  doc.clear();
+
+  JsonSnapshotHeader header;
+  size_t n = reader.readBytes(reinterpret_cast<char*>(&header), sizeof(header));
+  if (n == 0)
+    return DeserializationError::EmptyInput;
+  if (n != sizeof(header))
+    return DeserializationError::IncompleteInput;
+  if (strncmp(header.signature, jsonSignature(), sizeof(header.signature)) !=
+          0 ||
+      header.layout != jsonSnapshotLayout() ||
+      header.variantsSize % sizeof(VariantSlot) != 0)
+    return DeserializationError::InvalidInput;
+
+  char *strings, *variants;
+  if (!doc.memoryPool().allocSnapshot(header.stringsSize, header.variantsSize,
+                                      &strings, &variants)) {
+    doc.clear();
+    return DeserializationError::NoMemory;
+  }
+
+  VariantData& root = doc.data();
+  if (reader.readBytes(strings, header.stringsSize) != header.stringsSize ||
+      reader.readBytes(variants, header.variantsSize) != header.variantsSize ||
+      reader.readBytes(reinterpret_cast<char*>(&root), sizeof(VariantData)) !=
+          sizeof(VariantData)) {
+    doc.clear();
+    return DeserializationError::IncompleteInput;
+  }
+
+  // The root moves with the variants, like in the pool
+  root.movePointers(
+      ptrdiff_t(reinterpret_cast<uintptr_t>(strings) - header.strings),
+      ptrdiff_t(reinterpret_cast<uintptr_t>(variants) - header.variants));
+  return DeserializationError::Ok;
+}
+
+// loadSnapshot(JsonDocument&, const std::string&);
+// loadSnapshot(JsonDocument&, const String&);
+template <typename TString>
+typename enable_if<!is_array<TString>::value, DeserializationError>::type
+loadSnapshot(JsonDocument& doc, const TString& input) {
+  Reader<TString> reader(input);
+  return doLoadSnapshot(doc, reader);
+}
+
+// loadSnapshot(JsonDocument&, std::istream&);
+// loadSnapshot(JsonDocument&, Stream&);
+template <typename TStream>
+DeserializationError loadSnapshot(JsonDocument& doc, TStream& input) {
+  Reader<TStream> reader(input);
+  return doLoadSnapshot(doc, reader);
+}
+
+// loadSnapshot(JsonDocument&, char*, size_t);
+// loadSnapshot(JsonDocument&, const char*, size_t);
+// loadSnapshot(JsonDocument&, const void*, size_t);
+template <typename TChar>
+DeserializationError loadSnapshot(JsonDocument& doc, TChar* input,
+                                  size_t inputSize) {
+  BoundedReader<TChar*> reader(input, inputSize);
+  return doLoadSnapshot(doc, reader);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
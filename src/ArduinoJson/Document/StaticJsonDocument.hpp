@@ -14,10 +14,10 @@ class StaticJsonDocument : public JsonDocument {
       AddPadding<Max<1, desiredCapacity>::value>::value;
 
  public:
-  StaticJsonDocument() : JsonDocument(_buffer, _capacity) {}
+  StaticJsonDocument() : JsonDocument(_buffer, sizeof(_buffer)) {}
 
   StaticJsonDocument(const StaticJsonDocument& src)
-      : JsonDocument(_buffer, _capacity) {
+      : JsonDocument(_buffer, sizeof(_buffer)) {
     set(src);
   }
 
@@ -25,12 +25,12 @@ class StaticJsonDocument : public JsonDocument {
   StaticJsonDocument(
       const T& src,
       typename enable_if<is_convertible<T, VariantConstRef>::value>::type* = 0)
-      : JsonDocument(_buffer, _capacity) {
+      : JsonDocument(_buffer, sizeof(_buffer)) {
     set(src);
   }
 
   // disambiguate
-  StaticJsonDocument(VariantRef src) : JsonDocument(_buffer, _capacity) {
+  StaticJsonDocument(VariantRef src) : JsonDocument(_buffer, sizeof(_buffer)) {
     set(src);
   }
 
@@ -51,7 +51,7 @@ class StaticJsonDocument : public JsonDocument {
   }
 
  private:
-  char _buffer[_capacity];
+  char _buffer[_capacity + rootVariantSize];
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
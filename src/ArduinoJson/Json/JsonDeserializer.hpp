@@ -19,6 +19,12 @@ namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TReader, typename TStringStorage>
 class JsonDeserializer {
+  // use the tokenizer below
+  template <typename TInput, size_t maxStringLength>
+  friend class JsonPullParser;
+  template <size_t maxDepth, size_t maxTokenLength>
+  friend class ResumableJsonDeserializer;
+
  public:
   JsonDeserializer(MemoryPool &pool, TReader reader,
                    TStringStorage stringStorage)
@@ -41,7 +47,25 @@ class JsonDeserializer {
     return _error;
   }
 
+  // Measures the input to get the capacity that parse() needs, without a
+  // filter. Returns 0 if the input is invalid.
+  // Requires TStringStorage == StringCounter.
+  size_t estimateCapacity(NestingLimit nestingLimit) {
+    Capacity capacity = {0, 0};
+    if (!measureVariant(capacity, nestingLimit))
+      return 0;
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION && ARDUINOJSON_ENABLE_STRING_TABLE
+    capacity.bytes += MemoryPool::stringTableMemoryUsage(capacity.strings);
+#endif
+    return capacity.bytes;
+  }
+
  private:
+  struct Capacity {
+    size_t bytes;    // slots, strings, and tables
+    size_t strings;  // number of strings copied in the pool
+  };
+
   char current() {
     return _latch.current();
   }
@@ -111,6 +135,42 @@ class JsonDeserializer {
     }
   }
 
+  bool measureVariant(Capacity &capacity, NestingLimit nestingLimit) {
+    if (!skipSpacesAndComments())
+      return false;
+
+    switch (current()) {
+      case '[':
+        return measureArray(capacity, nestingLimit);
+
+      case '{':
+        return measureObject(capacity, nestingLimit);
+
+      case '\"':
+      case '\'':
+        _stringStorage.startString();
+        if (!parseQuotedString())
+          return false;
+        addString(capacity);
+        return true;
+
+      default: {
+        // Same checks as parse(), so an invalid token makes the estimate 0
+        VariantData value;
+        value.init();
+        return parseNumericValue(value);
+      }
+    }
+  }
+
+  void addString(Capacity &capacity) {
+    size_t n = _stringStorage.storageSize();
+    if (n) {
+      capacity.bytes += n;
+      capacity.strings++;
+    }
+  }
+
   template <typename TFilter>
   bool parseArray(CollectionData &array, TFilter filter,
                   NestingLimit nestingLimit) {
@@ -195,6 +255,46 @@ class JsonDeserializer {
     }
   }
 
+  bool measureArray(Capacity &capacity, NestingLimit nestingLimit) {
+    if (nestingLimit.reached()) {
+      _error = DeserializationError::TooDeep;
+      return false;
+    }
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    if (!skipSpacesAndComments())
+      return false;
+
+    // Empty array?
+    if (eat(']'))
+      return true;
+
+    // Measure each value
+    for (size_t size = 1;; size++) {
+      // 1 - Measure value
+      if (!measureVariant(capacity, nestingLimit.decrement()))
+        return false;
+
+      // 2 - Skip spaces
+      if (!skipSpacesAndComments())
+        return false;
+
+      // 3 - More values?
+      if (eat(']')) {
+        capacity.bytes += CollectionData::estimateMemoryUsage(size, false);
+        return true;
+      }
+      if (!eat(',')) {
+        _error = DeserializationError::InvalidInput;
+        return false;
+      }
+    }
+  }
+
   template <typename TFilter>
   bool parseObject(CollectionData &object, TFilter filter,
                    NestingLimit nestingLimit) {
@@ -332,6 +432,66 @@ class JsonDeserializer {
     }
   }
 
+  // Duplicate keys are counted twice, like the other duplicate strings
+  bool measureObject(Capacity &capacity, NestingLimit nestingLimit) {
+    if (nestingLimit.reached()) {
+      _error = DeserializationError::TooDeep;
+      return false;
+    }
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    if (!skipSpacesAndComments())
+      return false;
+
+    // Empty object?
+    if (eat('}'))
+      return true;
+
+    // Measure each key value pair
+    for (size_t size = 1;; size++) {
+      // Measure key
+      if (!parseKey())
+        return false;
+      addString(capacity);
+
+      // Skip spaces
+      if (!skipSpacesAndComments())
+        return false;
+
+      // Colon
+      if (!eat(':')) {
+        _error = DeserializationError::InvalidInput;
+        return false;
+      }
+
+      // Measure value
+      if (!measureVariant(capacity, nestingLimit.decrement()))
+        return false;
+
+      // Skip spaces
+      if (!skipSpacesAndComments())
+        return false;
+
+      // More keys/values?
+      if (eat('}')) {
+        capacity.bytes += CollectionData::estimateMemoryUsage(size, true);
+        return true;
+      }
+      if (!eat(',')) {
+        _error = DeserializationError::InvalidInput;
+        return false;
+      }
+
+      // Skip spaces
+      if (!skipSpacesAndComments())
+        return false;
+    }
+  }
+
   bool parseKey() {
     _stringStorage.startString();
     if (isQuote(current())) {
@@ -357,6 +517,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      _latch.appendStringChars(_stringStorage, stopChar);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -437,6 +599,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      _latch.skipStringChars(stopChar);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -455,7 +619,10 @@ class JsonDeserializer {
   }
 
   bool parseNumericValue(VariantData &result) {
-    uint8_t n = 0;
+    if (_latch.readInteger(canBeInNonQuotedString, result))
+      return true;
+
+    uint8_t n = uint8_t(_latch.readWhile(canBeInNonQuotedString, _buffer, 63));
 
     char c = current();
     while (canBeInNonQuotedString(c) && n < 63) {
@@ -500,6 +667,7 @@ class JsonDeserializer {
   }
 
   bool skipNumericValue() {
+    _latch.skipWhile(canBeInNonQuotedString);
     char c = current();
     while (canBeInNonQuotedString(c)) {
       move();
@@ -549,6 +717,8 @@ class JsonDeserializer {
 
   bool skipSpacesAndComments() {
     for (;;) {
+      _latch.skipSpaces();
+
       switch (current()) {
         // end of string
         case '\0':
@@ -732,4 +902,32 @@ DeserializationError deserializeJson(JsonDocument &doc, TChar *input,
                                        filter);
 }
 
+//
+// estimateJsonCapacity(const std::string&, ...)
+// estimateJsonCapacity(char*, ...)
+//
+// Returns the capacity that deserializeJson() needs for this input, without a
+// filter. It's exact unless the input contains duplicate strings, which are
+// counted twice. Returns 0 if the input is invalid.
+template <typename TString>
+size_t estimateJsonCapacity(const TString &input,
+                            NestingLimit nestingLimit = NestingLimit()) {
+  return estimateCapacity<JsonDeserializer>(input, nestingLimit);
+}
+
+template <typename TChar>
+size_t estimateJsonCapacity(TChar *input,
+                            NestingLimit nestingLimit = NestingLimit()) {
+  return estimateCapacity<JsonDeserializer>(input, nestingLimit);
+}
+
+//
+// estimateJsonCapacity(char*, size_t, ...)
+//
+template <typename TChar>
+size_t estimateJsonCapacity(TChar *input, size_t inputSize,
+                            NestingLimit nestingLimit = NestingLimit()) {
+  return estimateCapacity<JsonDeserializer>(input, inputSize, nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
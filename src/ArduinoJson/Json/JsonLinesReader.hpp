@@ -0,0 +1,275 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+#include <string.h>  // memchr, memmove
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Reads the documents of a JSON Lines (or NDJSON) input, one per line:
+//
+//   JsonLinesReader lines(stream, buffer, sizeof(buffer));
+//   DeserializationError err;
+//   while ((err = lines.next(doc)) != DeserializationError::EmptyInput) {
+//     ...
+//   }
+//
+// next() clears the document, so all the lines reuse the same pool.
+// The blank lines are skipped. After an error, the reader resumes at the next
+// line, and lineNumber() tells which line failed.
+class JsonLinesReader {
+ public:
+  // Reads the lines of a buffer in place; the strings are copied in the
+  // document
+  JsonLinesReader(const char* input, size_t inputSize) {
+    initBuffer(input, inputSize);
+    _inPlace = false;
+  }
+
+  // Reads the lines of a buffer in place; the strings remain in the buffer,
+  // which is modified (zero-copy mode), except with ARDUINOJSON_COMPACT_SLOTS
+  JsonLinesReader(char* input, size_t inputSize) {
+    initBuffer(input, inputSize);
+    _inPlace = true;
+  }
+
+  // Reads the lines of a stream (std::istream, Stream...) in a buffer that
+  // must be able to hold the longest line.
+  // By default, it reads the stream one character at a time, so the stream
+  // stops right after the newline of the last document returned.
+  // With prefetch, it reads the stream in blocks as big as the buffer, which
+  // is faster, but the stream goes beyond the last document.
+  template <typename TStream>
+  JsonLinesReader(TStream& stream, char* buffer, size_t bufferSize,
+                  bool prefetch = false)
+      : _ptr(buffer),
+        _end(buffer),
+        _inPlace(false),
+        _stream(&stream),
+        _read(&readChar<TStream>),
+        _readBytes(&readBytes<TStream>),
+        _buffer(buffer),
+        _bufferSize(bufferSize),
+        _prefetch(prefetch),
+        _skipping(false),
+        _lineNumber(0) {}
+
+  // Deserializes the next document in doc.
+  // Returns EmptyInput at the end of the input, and NoMemory if the line is
+  // longer than the buffer.
+  DeserializationError next(JsonDocument& doc,
+                            NestingLimit nestingLimit = NestingLimit()) {
+    Line line;
+    while (nextLine(line)) {
+      doc.clear();
+      if (line.truncated)
+        return DeserializationError::NoMemory;
+      DeserializationError err =
+          parseLine(line, doc.data(), doc.memoryPool(), nestingLimit);
+      if (err != DeserializationError::EmptyInput)
+        return err;
+    }
+    doc.clear();
+    return DeserializationError::EmptyInput;
+  }
+
+  // Deserializes the next `maxLines` documents in an array, which saves the
+  // calls to next() when the documents are small.
+  // Returns EmptyInput at the end of the input. If a line fails, it returns
+  // the error, and the array contains the documents that precede it.
+  DeserializationError nextBatch(JsonDocument& doc, size_t maxLines,
+                                 NestingLimit nestingLimit = NestingLimit()) {
+    doc.clear();
+    MemoryPool& pool = doc.memoryPool();
+    CollectionData& array = doc.data().toArray();
+    size_t count = 0;
+    Line line;
+    while (count < maxLines && nextLine(line)) {
+      if (line.truncated)
+        return DeserializationError::NoMemory;
+      // The value must be parsed in place, as variants can't be moved with
+      // ARDUINOJSON_COMPACT_SLOTS
+      VariantData* element = array.addElement(&pool);
+      if (!element)
+        return DeserializationError::NoMemory;
+      DeserializationError err = parseLine(line, *element, pool, nestingLimit);
+      if (err) {
+        array.removeElement(count, &pool);
+        if (err != DeserializationError::EmptyInput)
+          return err;
+        continue;
+      }
+      count++;
+    }
+    return count ? DeserializationError::Ok : DeserializationError::EmptyInput;
+  }
+
+  // Number of the last line read, starting at 1
+  size_t lineNumber() const {
+    return _lineNumber;
+  }
+
+ private:
+  struct Line {
+    const char* begin;
+    const char* end;  // excluding the newline
+    bool truncated;   // true if the line didn't fit in the buffer
+  };
+
+  void initBuffer(const char* input, size_t inputSize) {
+    // Like the other readers, we treat '\0' as the end of the input
+    const void* terminator = memchr(input, 0, inputSize);
+    _ptr = input;
+    _end =
+        terminator ? static_cast<const char*>(terminator) : input + inputSize;
+    _stream = 0;
+    _read = 0;
+    _readBytes = 0;
+    _buffer = 0;
+    _bufferSize = 0;
+    _prefetch = false;
+    _skipping = false;
+    _lineNumber = 0;
+  }
+
+  bool nextLine(Line& line) {
+    bool found;
+    if (!_stream)
+      found = nextLineInBuffer(line);
+    else if (_prefetch)
+      found = prefetchLine(line);
+    else
+      found = readLine(line);
+    if (found)
+      _lineNumber++;
+    return found;
+  }
+
+  bool nextLineInBuffer(Line& line) {
+    if (_ptr == _end)
+      return false;
+    const char* newline =
+        static_cast<const char*>(memchr(_ptr, '\n', size_t(_end - _ptr)));
+    line.begin = _ptr;
+    line.end = newline ? newline : _end;
+    line.truncated = false;
+    _ptr = newline ? newline + 1 : _end;
+    return true;
+  }
+
+  // Reads the stream up to the next newline, included
+  bool readLine(Line& line) {
+    size_t n = 0;
+    bool truncated = false;
+    int c;
+    for (;;) {
+      c = _read(_stream);
+      if (c < 0 || c == '\n')
+        break;
+      if (n < _bufferSize)
+        _buffer[n++] = static_cast<char>(c);
+      else
+        truncated = true;
+    }
+    if (c < 0 && n == 0 && !truncated)  // end of stream
+      return false;
+    line.begin = _buffer;
+    line.end = _buffer + n;
+    line.truncated = truncated;
+    return true;
+  }
+
+  // Reads the stream in blocks; the characters that follow the newline
+  // remain in the buffer for the next line
+  bool prefetchLine(Line& line) {
+    for (;;) {
+      const char* newline =
+          static_cast<const char*>(memchr(_ptr, '\n', size_t(_end - _ptr)));
+      if (newline) {
+        line.begin = _ptr;
+        line.end = _skipping ? _ptr : newline;
+        line.truncated = _skipping;
+        _ptr = newline + 1;
+        _skipping = false;
+        return true;
+      }
+
+      size_t pending = _skipping ? 0 : size_t(_end - _ptr);
+      memmove(_buffer, _ptr, pending);
+      _ptr = _buffer;
+      _end = _buffer + pending;
+      if (pending == _bufferSize) {  // the line fills the buffer
+        int c = _read(_stream);
+        if (c < 0 || c == '\n') {
+          line.begin = _buffer;
+          line.end = _end;
+          line.truncated = false;
+          _ptr = _end = _buffer;
+          return true;
+        }
+        _skipping = true;
+        _end = _buffer;
+        continue;
+      }
+
+      size_t n = _readBytes(_stream, _buffer + pending, _bufferSize - pending);
+      if (n == 0) {  // end of stream
+        if (pending == 0 && !_skipping)
+          return false;
+        line.begin = _buffer;
+        line.end = _end;
+        line.truncated = _skipping;
+        _skipping = false;
+        _ptr = _end;
+        return true;
+      }
+      _end += n;
+    }
+  }
+
+  DeserializationError parseLine(const Line& line, VariantData& variant,
+                                 MemoryPool& pool, NestingLimit nestingLimit) {
+    BoundedReader<const char*> reader(line.begin,
+                                      size_t(line.end - line.begin));
+#if !ARDUINOJSON_COMPACT_SLOTS  // a CompactPointer can't point to the input
+    if (_inPlace)
+      return makeDeserializer<JsonDeserializer>(
+                 pool, reader, StringMover(const_cast<char*>(line.begin)))
+          .parse(variant, AllowAllFilter(), nestingLimit);
+#endif
+    return makeDeserializer<JsonDeserializer>(pool, reader, StringCopier(pool))
+        .parse(variant, AllowAllFilter(), nestingLimit);
+  }
+
+  template <typename TStream>
+  static int readChar(void* stream) {
+    return Reader<TStream>(*static_cast<TStream*>(stream)).read();
+  }
+
+  template <typename TStream>
+  static size_t readBytes(void* stream, char* buffer, size_t length) {
+    return Reader<TStream>(*static_cast<TStream*>(stream))
+        .readBytes(buffer, length);
+  }
+
+  // pending characters: the whole input, or the prefetched part of the stream
+  const char* _ptr;
+  const char* _end;
+  bool _inPlace;
+
+  void* _stream;
+  int (*_read)(void* stream);
+  size_t (*_readBytes)(void* stream, char* buffer, size_t length);
+  char* _buffer;
+  size_t _bufferSize;
+  bool _prefetch;
+  bool _skipping;  // true while discarding the rest of a line that is too long
+
+  size_t _lineNumber;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
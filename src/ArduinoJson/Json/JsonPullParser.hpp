@@ -0,0 +1,262 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Variant/VariantRef.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Reads a JSON document as a sequence of events, without building a tree, so
+// it can process inputs of any size in constant memory:
+//
+//   JsonPullParser<std::istream> parser(stream);
+//   for (;;) {
+//     switch (parser.next()) {
+//       case JsonPullParser<std::istream>::Key: ...
+//       case JsonPullParser<std::istream>::NumberValue: ...
+//       ...
+//     }
+//   }
+//
+// It uses the tokenizer of JsonDeserializer, so it supports the same inputs
+// and the same syntax. The strings (keys and values) are copied in a buffer
+// of `maxStringLength` characters, which the next event overwrites.
+// The parser stops after the first value, like deserializeJson() with a
+// stream.
+template <typename TInput, size_t maxStringLength = 255>
+class JsonPullParser {
+ public:
+  enum Event {
+    StartObject,
+    EndObject,
+    StartArray,
+    EndArray,
+    Key,           // see value()
+    StringValue,   // see value()
+    NumberValue,   // see value()
+    BooleanValue,  // see value()
+    NullValue,
+    EndOfDocument,
+    Error  // see error()
+  };
+
+  explicit JsonPullParser(TInput& input,
+                          NestingLimit nestingLimit = NestingLimit())
+      : _pool(_buffer, sizeof(_buffer)),
+        _deserializer(_pool, Reader<TInput>(input), StringCopier(_pool)) {
+    init(nestingLimit);
+  }
+
+  explicit JsonPullParser(const TInput& input,
+                          NestingLimit nestingLimit = NestingLimit())
+      : _pool(_buffer, sizeof(_buffer)),
+        _deserializer(_pool, Reader<TInput>(input), StringCopier(_pool)) {
+    init(nestingLimit);
+  }
+
+  // Reads the next event; after EndOfDocument or Error, it returns the same
+  // event again.
+  Event next() {
+    if (_state == Done)
+      return _error ? Error : EndOfDocument;
+    Event event = readEvent();
+    if (event == Error)
+      _state = Done;
+    return event;
+  }
+
+  // The key, or the value, of the last event
+  VariantConstRef value() const {
+    return VariantConstRef(&_value);
+  }
+
+  // The reason of the last Error event
+  DeserializationError error() const {
+    return _error;
+  }
+
+  // Number of arrays and objects that contain the current position
+  size_t depth() const {
+    return _depth;
+  }
+
+ private:
+  typedef JsonDeserializer<Reader<TInput>, StringCopier> Tokenizer;
+
+  enum State {
+    ValueExpected,      // at the beginning, or after ':' or ','
+    FirstElement,       // after '['
+    FirstMember,        // after '{'
+    KeyExpected,        // after ',' in an object
+    SeparatorExpected,  // after a value
+    Done                // after the first value, or after an error
+  };
+
+  static const size_t maxDepth = 255;  // the highest NestingLimit
+  static const size_t _capacity = AddPadding<maxStringLength + 1>::value;
+
+  void init(NestingLimit nestingLimit) {
+    _value.init();
+    _error = DeserializationError::Ok;
+    _state = ValueExpected;
+    _depth = 0;
+    _maxDepth = 0;
+    for (; !nestingLimit.reached(); nestingLimit = nestingLimit.decrement())
+      _maxDepth++;
+  }
+
+  Event readEvent() {
+    switch (_state) {
+      case FirstElement:
+        if (!skipSpaces())
+          return Error;
+        if (_deserializer.eat(']'))
+          return endCollection(EndArray);
+        return readValue();
+
+      case FirstMember:
+        if (!skipSpaces())
+          return Error;
+        if (_deserializer.eat('}'))
+          return endCollection(EndObject);
+        return readKey();
+
+      case KeyExpected:
+        if (!skipSpaces())
+          return Error;
+        return readKey();
+
+      case SeparatorExpected:
+        return readSeparator();
+
+      default:
+        return readValue();
+    }
+  }
+
+  Event readValue() {
+    if (!skipSpaces())
+      return Error;
+    switch (_deserializer.current()) {
+      case '[':
+        return startCollection(StartArray);
+
+      case '{':
+        return startCollection(StartObject);
+
+      case '\"':
+      case '\'':
+        _deserializer._stringStorage.startString();
+        if (!_deserializer.parseQuotedString())
+          return fail();
+        _value.setString(_deserializer._stringStorage.str());
+        return valueRead(StringValue);
+
+      default:
+        _value.setNull();
+        if (!_deserializer.parseNumericValue(_value))
+          return fail();
+        if (_value.isBoolean())
+          return valueRead(BooleanValue);
+        if (_value.isNull())
+          return valueRead(NullValue);
+        return valueRead(NumberValue);
+    }
+  }
+
+  Event readKey() {
+    if (!_deserializer.parseKey())
+      return fail();
+    _value.setString(_deserializer._stringStorage.str());
+    if (!skipSpaces())
+      return Error;
+    if (!_deserializer.eat(':'))
+      return fail(DeserializationError::InvalidInput);
+    _state = ValueExpected;
+    return Key;
+  }
+
+  Event readSeparator() {
+    if (!skipSpaces())
+      return Error;
+    bool inObject = isObject(_depth - 1);
+    if (_deserializer.eat(inObject ? '}' : ']'))
+      return endCollection(inObject ? EndObject : EndArray);
+    if (!_deserializer.eat(','))
+      return fail(DeserializationError::InvalidInput);
+    _state = inObject ? KeyExpected : ValueExpected;
+    return readEvent();
+  }
+
+  Event startCollection(Event event) {
+    if (_depth == _maxDepth)
+      return fail(DeserializationError::TooDeep);
+    _deserializer.move();
+    setObject(_depth, event == StartObject);
+    _depth++;
+    _state = event == StartObject ? FirstMember : FirstElement;
+    return event;
+  }
+
+  Event endCollection(Event event) {
+    _depth--;
+    return valueRead(event);
+  }
+
+  Event valueRead(Event event) {
+    if (_depth == 0)
+      _state = Done;
+    else
+      _state = SeparatorExpected;
+    return event;
+  }
+
+  bool skipSpaces() {
+    if (_deserializer.skipSpacesAndComments())
+      return true;
+    fail();
+    return false;
+  }
+
+  Event fail() {
+    return fail(_deserializer._error);
+  }
+
+  Event fail(DeserializationError error) {
+    _error = error;
+    return Error;
+  }
+
+  bool isObject(size_t depth) const {
+    return (_stack[depth / 8] >> (depth % 8)) & 1;
+  }
+
+  void setObject(size_t depth, bool value) {
+    uint8_t mask = uint8_t(1 << (depth % 8));
+    if (value)
+      _stack[depth / 8] |= mask;
+    else
+      _stack[depth / 8] &= uint8_t(~mask);
+  }
+
+  // non-copyable, as the pool points to the buffer
+  JsonPullParser(const JsonPullParser&);
+  JsonPullParser& operator=(const JsonPullParser&);
+
+  // The buffer goes first, so it's aligned like the class
+  char _buffer[_capacity + rootVariantSize];
+  MemoryPool _pool;
+  Tokenizer _deserializer;
+  VariantData _value;
+  DeserializationError _error;
+  State _state;
+  size_t _depth;
+  size_t _maxDepth;
+  uint8_t _stack[(maxDepth + 7) / 8];  // 1 for objects, 0 for arrays
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -4,11 +4,18 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/Scanner.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <string.h>  // memchr, memcpy
 
 namespace ARDUINOJSON_NAMESPACE {
 
-template <typename TReader>
+template <typename TReader, typename Enable = void>
 class Latch {
  public:
   Latch(TReader reader) : _reader(reader), _loaded(false) {
@@ -32,6 +39,26 @@ class Latch {
     return _current;
   }
 
+  // The bulk operations below are only implemented for contiguous inputs.
+  // Here, we read one character at a time, so the caller does all the work.
+
+  void skipSpaces() {}
+
+  template <typename TStringStorage>
+  void appendStringChars(TStringStorage&, char) {}
+
+  void skipStringChars(char) {}
+
+  size_t readWhile(bool (*)(char), char*, size_t) {
+    return 0;
+  }
+
+  void skipWhile(bool (*)(char)) {}
+
+  bool readInteger(bool (*)(char), VariantData&) {
+    return false;
+  }
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!_ended);
@@ -53,4 +80,123 @@ class Latch {
 #endif
 };
 
+// Latch for a contiguous buffer in RAM.
+// Instead of pulling characters one by one from the reader, it works directly
+// on the pointer range, which allows skipping or copying runs of characters.
+// Like with the other readers, a '\0' is treated as the end of the input.
+// When the reader has no other end, the terminator is located as the parsing
+// goes, one window at a time, so we never scan far beyond the document.
+template <typename TReader>
+class Latch<TReader, typename enable_if<IsRamReader<TReader>::value>::type> {
+ public:
+  Latch(TReader reader) : _ptr(reader.ptr()), _end(knownEnd(reader)) {}
+
+  void clear() {
+    if (hasMore(_ptr))
+      _ptr++;
+  }
+
+  int last() const {
+    return current();
+  }
+
+  FORCE_INLINE char current() const {
+    return hasMore(_ptr) ? *_ptr : 0;
+  }
+
+  // Skips spaces, tabs, and line breaks
+  void skipSpaces() {
+    do {
+      reserve();
+      _ptr = Scanner::skipSpaces(_ptr, _end);
+    } while (_ptr == _end && !endFound());
+  }
+
+  // Appends the characters of a quoted string up to the closing quote, the
+  // next escape sequence, the next control character, or the end of input
+  // (whichever comes first)
+  template <typename TStringStorage>
+  void appendStringChars(TStringStorage& storage, char stopChar) {
+    const char* begin = _ptr;
+    skipStringChars(stopChar);
+    storage.append(begin, size_t(_ptr - begin));
+  }
+
+  void skipStringChars(char stopChar) {
+    do {
+      reserve();
+      _ptr = Scanner::findSpecialStringChar(_ptr, _end, stopChar);
+    } while (_ptr == _end && !endFound());
+  }
+
+  // Copies at most maxSize characters, as long as they satisfy the predicate
+  size_t readWhile(bool (*predicate)(char), char* buffer, size_t maxSize) {
+    const char* begin = _ptr;
+    while (size_t(_ptr - begin) < maxSize && hasMore(_ptr) && predicate(*_ptr))
+      _ptr++;
+    size_t n = size_t(_ptr - begin);
+    memcpy(buffer, begin, n);
+    return n;
+  }
+
+  // Skips the characters that satisfy the predicate
+  void skipWhile(bool (*predicate)(char)) {
+    while (hasMore(_ptr) && predicate(*_ptr)) _ptr++;
+  }
+
+  // Parses an integer without copying it first (see parseInteger()).
+  // Returns false and leaves the input untouched if the token is something
+  // else, like a float.
+  bool readInteger(bool (*canBeInToken)(char), VariantData& result) {
+    reserve();  // the window is longer than any integer
+    const char* p = parseInteger(_ptr, _end, canBeInToken, result);
+    if (!p)
+      return false;
+    _ptr = p;
+    return true;
+  }
+
+ private:
+  static const bool _nullTerminated = IsNullTerminatedReader<TReader>::value;
+  static const ptrdiff_t _window = 256;
+
+  template <typename TSource>
+  static const char* knownEnd(const Reader<TSource*>& reader) {
+    return reader.ptr();  // nothing is known yet
+  }
+
+  static const char* knownEnd(const IteratorReader<const char*>& reader) {
+    return reader.end();
+  }
+
+  bool hasMore(const char* p) const {
+    if (_nullTerminated)
+      return *p != 0;
+    return p < _end;
+  }
+
+  bool endFound() const {
+    return !_nullTerminated || *_end == 0;
+  }
+
+  // Makes sure that the known part of the input extends to at least _window
+  // characters after _ptr, or to the terminator
+  FORCE_INLINE void reserve() {
+    if (_nullTerminated && _end - _ptr < _window && *_end)
+      extend();
+  }
+
+  void extend() {
+    const char* from = _ptr > _end ? _ptr : _end;
+    // memchr() stops at the first match, so it doesn't read beyond the input
+    const void* terminator = memchr(from, 0, _window);
+    _end = terminator ? static_cast<const char*>(terminator) : from + _window;
+  }
+
+  const char* _ptr;
+  // The end of the input, or, with a null-terminated input, the end of the
+  // part where we know there is no terminator
+  const char* _end;
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,320 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Deserializes a document that arrives in chunks, like the body of a request
+// on a non-blocking socket:
+//
+//   ResumableJsonDeserializer<> parser(doc);
+//   // for each chunk:
+//   DeserializationError err = parser.feed(chunk, chunkSize);
+//   // IncompleteInput: wait for the next chunk
+//   // Ok: the document is complete
+//   // anything else: the input is invalid
+//
+// The document grows as the chunks arrive, so nothing is lost at the end of a
+// chunk: the parser keeps the containers that are still open (at most
+// `maxDepth`, which acts as the NestingLimit), and the bytes of the token that
+// the chunk cuts (at most `maxTokenLength`; a longer token is fine if it's
+// entirely in one chunk).
+// Comments are not supported.
+template <size_t maxDepth = ARDUINOJSON_DEFAULT_NESTING_LIMIT,
+          size_t maxTokenLength = 255>
+class ResumableJsonDeserializer {
+ public:
+  explicit ResumableJsonDeserializer(JsonDocument& doc)
+      : _doc(&doc),
+        _state(ValueExpected),
+        _depth(0),
+        _member(0),
+        _tokenLength(0),
+        _inToken(false),
+        _foundSomething(false),
+        _finished(false),
+        _error(DeserializationError::IncompleteInput) {
+    doc.clear();
+  }
+
+  // Parses the next chunk of the input.
+  // Returns IncompleteInput until the document is complete, then Ok; the
+  // characters that follow the document are ignored.
+  // A '\0' ends the input like finish(): the result is final, even if it's
+  // IncompleteInput.
+  DeserializationError feed(const char* chunk, size_t chunkSize) {
+    const char* end = chunk + chunkSize;
+    const char* p = chunk;
+    while (!_finished && _error == DeserializationError::IncompleteInput &&
+           p < end) {
+      if (_inToken)
+        p = continueToken(p, end);
+      else
+        p = parseChar(p, end);
+    }
+    return _error;
+  }
+
+  // Tells that there are no more chunks.
+  // This is required when the document is a single number, like "42", as
+  // nothing else tells where it ends.
+  DeserializationError finish() {
+    _finished = true;
+    if (_error != DeserializationError::IncompleteInput)
+      return _error;
+    if (_inToken && !_inString && _depth == 0) {
+      _inToken = false;
+      parseToken(_token, _tokenLength);
+    } else if (!_foundSomething) {
+      _error = DeserializationError::EmptyInput;
+    }
+    return _error;
+  }
+
+ private:
+  typedef JsonDeserializer<BoundedReader<const char*>, StringCopier> Tokenizer;
+
+  enum State {
+    ValueExpected,      // at the beginning, or after ':' or ','
+    FirstElement,       // after '['
+    FirstMember,        // after '{'
+    KeyExpected,        // after ',' in an object
+    ColonExpected,      // after a key
+    SeparatorExpected   // after a value
+  };
+
+  const char* parseChar(const char* p, const char* end) {
+    char c = *p;
+    switch (c) {
+      case '\0':  // like the other readers, we treat '\0' as the end
+        finish();
+        return end;
+
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        return p + 1;
+    }
+    _foundSomething = true;
+
+    switch (_state) {
+      case FirstElement:
+        if (c == ']')
+          return endCollection(p);
+        return startValue(p, end);
+
+      case FirstMember:
+        if (c == '}')
+          return endCollection(p);
+        return startToken(p, end);
+
+      case KeyExpected:
+        return startToken(p, end);
+
+      case ColonExpected:
+        if (c != ':')
+          return fail(DeserializationError::InvalidInput);
+        _state = ValueExpected;
+        return p + 1;
+
+      case SeparatorExpected:
+        if (c == (top()->isObject() ? '}' : ']'))
+          return endCollection(p);
+        if (c != ',')
+          return fail(DeserializationError::InvalidInput);
+        _state = top()->isObject() ? KeyExpected : ValueExpected;
+        return p + 1;
+
+      default:
+        return startValue(p, end);
+    }
+  }
+
+  const char* startValue(const char* p, const char* end) {
+    if (*p != '[' && *p != '{')
+      return startToken(p, end);
+
+    if (_depth == maxDepth)
+      return fail(DeserializationError::TooDeep);
+    VariantData* value = target();
+    if (!value)
+      return fail(DeserializationError::NoMemory);
+    if (*p == '[') {
+      value->toArray();
+      _state = FirstElement;
+    } else {
+      value->toObject();
+      _state = FirstMember;
+    }
+    _stack[_depth++] = value;
+    return p + 1;
+  }
+
+  const char* endCollection(const char* p) {
+    _depth--;
+    valueParsed();
+    return p + 1;
+  }
+
+  // The strings, numbers, literals, and keys
+  const char* startToken(const char* p, const char* end) {
+    _inString = *p == '\"' || *p == '\'';
+    if (_inString) {
+      _quote = *p;
+      _escaped = false;
+    } else if (!Tokenizer::canBeInNonQuotedString(*p)) {
+      return fail(DeserializationError::InvalidInput);
+    }
+
+    const char* tokenEnd = findTokenEnd(_inString ? p + 1 : p, end);
+    if (tokenEnd) {
+      parseToken(p, size_t(tokenEnd - p));
+      return tokenEnd;
+    }
+
+    // the chunk cuts the token, we keep its beginning for the next chunk
+    _inToken = true;
+    _tokenLength = 0;
+    return appendToken(p, end);
+  }
+
+  const char* continueToken(const char* p, const char* end) {
+    const char* tokenEnd = findTokenEnd(p, end);
+    if (!tokenEnd)
+      return appendToken(p, end);
+    appendToken(p, tokenEnd);
+    if (_error == DeserializationError::IncompleteInput) {
+      _inToken = false;
+      parseToken(_token, _tokenLength);
+    }
+    return tokenEnd;
+  }
+
+  const char* appendToken(const char* p, const char* end) {
+    size_t n = size_t(end - p);
+    if (_tokenLength + n > maxTokenLength)
+      return fail(DeserializationError::NoMemory);
+    memcpy(_token + _tokenLength, p, n);
+    _tokenLength += n;
+    return end;
+  }
+
+  // Returns the end of the token (after the closing quote of a string), or
+  // null if it goes beyond the chunk
+  const char* findTokenEnd(const char* p, const char* end) {
+    if (!_inString) {
+      while (p < end && Tokenizer::canBeInNonQuotedString(*p)) p++;
+      return p < end ? p : 0;
+    }
+    for (; p < end; p++) {
+      if (_escaped)
+        _escaped = false;
+      else if (*p == '\\')
+        _escaped = true;
+      else if (*p == _quote)
+        return p + 1;
+    }
+    return 0;
+  }
+
+  void parseToken(const char* token, size_t length) {
+    MemoryPool& pool = _doc->memoryPool();
+    BoundedReader<const char*> reader(token, length);
+    Tokenizer tokenizer(pool, reader, StringCopier(pool));
+
+    if (_state == FirstMember || _state == KeyExpected) {
+      parseKey(tokenizer);
+      return;
+    }
+
+    VariantData* value = target();
+    if (!value) {
+      fail(DeserializationError::NoMemory);
+      return;
+    }
+    DeserializationError err =
+        tokenizer.parse(*value, AllowAllFilter(), NestingLimit());
+    if (err)
+      fail(err);
+    else
+      valueParsed();
+  }
+
+  // Same as JsonDeserializer::parseObject()
+  void parseKey(Tokenizer& tokenizer) {
+    if (!tokenizer.parseKey()) {
+      fail(tokenizer._error);
+      return;
+    }
+    CollectionData* object = top()->asObject();
+    String key = tokenizer._stringStorage.str();
+    _member = object->getMember(adaptString(key.c_str()));
+    if (!_member) {
+      key = tokenizer._stringStorage.save();
+      VariantSlot* slot = object->addSlot(&_doc->memoryPool());
+      if (!slot) {
+        fail(DeserializationError::NoMemory);
+        return;
+      }
+      slot->setKey(key);
+      _member = slot->data();
+    }
+    _state = ColonExpected;
+  }
+
+  // The variant that receives the next value
+  VariantData* target() {
+    if (_depth == 0)
+      return &_doc->data();
+    if (top()->isObject())
+      return _member;
+    return top()->asArray()->addElement(&_doc->memoryPool());
+  }
+
+  void valueParsed() {
+    if (_depth == 0)
+      _error = DeserializationError::Ok;
+    else
+      _state = SeparatorExpected;
+  }
+
+  VariantData* top() const {
+    return _stack[_depth - 1];
+  }
+
+  const char* fail(DeserializationError error) {
+    // The tokens are complete, so IncompleteInput can only mean that they
+    // are truncated, like "tru"
+    if (error == DeserializationError::IncompleteInput)
+      error = DeserializationError::InvalidInput;
+    _error = error;
+    return 0;
+  }
+
+  JsonDocument* _doc;
+  State _state;
+  VariantData* _stack[maxDepth];  // the open arrays and objects
+  size_t _depth;
+  VariantData* _member;  // the value of the last key
+
+  // The token that the chunk cut
+  char _token[maxTokenLength];
+  size_t _tokenLength;
+  bool _inToken;
+  bool _inString;
+  bool _escaped;
+  char _quote;
+
+  bool _foundSomething;
+  bool _finished;  // true after finish() or '\0'
+  DeserializationError _error;  // IncompleteInput while parsing
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,227 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stdint.h>
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_SIMD
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define ARDUINOJSON_SIMD_AVX2 1
+#    define ARDUINOJSON_SIMD_SSE2 1
+#  elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define ARDUINOJSON_SIMD_SSE2 1
+#  elif defined(__ARM_NEON) && ARDUINOJSON_LITTLE_ENDIAN
+#    include <arm_neon.h>
+#    define ARDUINOJSON_SIMD_NEON 1
+#  endif
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Functions to scan a contiguous buffer in RAM.
+// They process several bytes at a time when ARDUINOJSON_ENABLE_SIMD is set
+// and fall back to a simpler loop otherwise.
+namespace Scanner {
+
+// mask must not be zero
+inline int countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#elif defined(__GNUC__) && __SIZEOF_INT__ >= 4
+  return __builtin_ctz(mask);
+#else
+  int n = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// mask must not be zero
+inline int countTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return static_cast<int>(index);
+#elif defined(__GNUC__) && __SIZEOF_LONG_LONG__ >= 8
+  return __builtin_ctzll(mask);
+#else
+  uint32_t low = static_cast<uint32_t>(mask);
+  if (low)
+    return countTrailingZeros(low);
+  return 32 + countTrailingZeros(static_cast<uint32_t>(mask >> 32));
+#endif
+}
+
+// Tells whether a character of a quoted string needs a special treatment:
+// closing quote, escape sequence, or control character (including the
+// terminator)
+inline bool isSpecialStringChar(char c, char stopChar) {
+  return c == stopChar || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+// Returns a pointer to the first special character of a quoted string (see
+// above), or end if there is none
+inline const char* findSpecialStringChar(const char* p, const char* end,
+                                         char stopChar) {
+#if defined(ARDUINOJSON_SIMD_AVX2)
+  {
+    const __m256i quote = _mm256_set1_epi8(stopChar);
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (end - p >= 32) {
+      __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      __m256i special = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                          _mm256_cmpeq_epi8(chunk, backslash)),
+          _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+      if (mask)
+        return p + countTrailingZeros(mask);
+      p += 32;
+    }
+  }
+#endif
+#if defined(ARDUINOJSON_SIMD_SSE2)
+  {
+    const __m128i quote = _mm_set1_epi8(stopChar);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (end - p >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      __m128i special =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                    _mm_cmpeq_epi8(chunk, backslash)),
+                       _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+      if (mask)
+        return p + countTrailingZeros(mask);
+      p += 16;
+    }
+  }
+#elif defined(ARDUINOJSON_SIMD_NEON)
+  {
+    const uint8x16_t quote = vdupq_n_u8(static_cast<uint8_t>(stopChar));
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    while (end - p >= 16) {
+      uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+      uint8x16_t special =
+          vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+                   vcltq_u8(chunk, space));
+      // narrow to 4 bits per byte, so the mask fits in a 64-bit integer
+      uint64_t mask = vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)),
+          0);
+      if (mask)
+        return p + (countTrailingZeros(mask) >> 2);
+      p += 16;
+    }
+  }
+#endif
+  while (p < end && !isSpecialStringChar(*p, stopChar)) p++;
+  return p;
+}
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+#if !defined(ARDUINOJSON_SIMD_SSE2) && !defined(ARDUINOJSON_SIMD_NEON) && \
+    ARDUINOJSON_LITTLE_ENDIAN && defined(__SIZEOF_POINTER__) &&           \
+    __SIZEOF_POINTER__ >= 8
+#  define ARDUINOJSON_SCANNER_SWAR 1
+
+// Sets the high bit of each byte of x that is different from c.
+// Unlike the classic "has zero byte" trick, this is exact for every byte.
+inline uint64_t nonEqualBytes(uint64_t x, char c) {
+  const uint64_t lowBits = 0x7F7F7F7F7F7F7F7FU;
+  x ^= 0x0101010101010101U * static_cast<unsigned char>(c);
+  return ((x & lowBits) + lowBits) | x;
+}
+#endif
+
+// Returns a pointer to the first character that is not a space, a tab, or a
+// line break, or end if there is none
+inline const char* skipSpaces(const char* p, const char* end) {
+  // In minified JSON, tokens are never preceded by a space, and in
+  // prettified JSON, there is often only one.
+  for (int i = 0; i < 2; i++) {
+    if (p == end || !isSpace(*p))
+      return p;
+    p++;
+  }
+#if defined(ARDUINOJSON_SIMD_SSE2)
+  {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      __m128i spaces =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                                    _mm_cmpeq_epi8(chunk, tab)),
+                       _mm_or_si128(_mm_cmpeq_epi8(chunk, cr),
+                                    _mm_cmpeq_epi8(chunk, lf)));
+      uint32_t mask =
+          ~static_cast<uint32_t>(_mm_movemask_epi8(spaces)) & 0xFFFF;
+      if (mask)
+        return p + countTrailingZeros(mask);
+      p += 16;
+    }
+  }
+#elif defined(ARDUINOJSON_SIMD_NEON)
+  {
+    const uint8x16_t space = vdupq_n_u8(' ');
+    const uint8x16_t tab = vdupq_n_u8('\t');
+    const uint8x16_t cr = vdupq_n_u8('\r');
+    const uint8x16_t lf = vdupq_n_u8('\n');
+    while (end - p >= 16) {
+      uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+      uint8x16_t spaces =
+          vorrq_u8(vorrq_u8(vceqq_u8(chunk, space), vceqq_u8(chunk, tab)),
+                   vorrq_u8(vceqq_u8(chunk, cr), vceqq_u8(chunk, lf)));
+      uint64_t mask = ~vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(spaces), 4)),
+          0);
+      if (mask)
+        return p + (countTrailingZeros(mask) >> 2);
+      p += 16;
+    }
+  }
+#elif defined(ARDUINOJSON_SCANNER_SWAR)
+  while (end - p >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, p, 8);
+    uint64_t mask = nonEqualBytes(chunk, ' ') & nonEqualBytes(chunk, '\t') &
+                    nonEqualBytes(chunk, '\r') & nonEqualBytes(chunk, '\n') &
+                    0x8080808080808080U;
+    if (mask)
+      return p + (countTrailingZeros(mask) >> 3);
+    p += 8;
+  }
+#endif
+  while (p < end && isSpace(*p)) p++;
+  return p;
+}
+
+}  // namespace Scanner
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -8,8 +8,11 @@
 #include <string.h>  // for strlen
 
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Scanner.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Numbers/ShortestFloat.hpp>
+#include <ArduinoJson/Numbers/formatInteger.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -36,15 +39,23 @@ class TextFormatter {
 
   void writeString(const char *value) {
     ARDUINOJSON_ASSERT(value != NULL);
-    writeRaw('\"');
-    while (*value) writeChar(*value++);
-    writeRaw('\"');
+    writeString(value, strlen(value));
   }
 
   void writeString(const char *value, size_t n) {
     ARDUINOJSON_ASSERT(value != NULL);
+    const char *end = value + n;
     writeRaw('\"');
-    while (n--) writeChar(*value++);
+    for (;;) {
+      // copy the characters that don't need to be escaped in one call
+      const char *special = Scanner::findSpecialStringChar(value, end, '\"');
+      if (special != value)
+        writeRaw(value, special);
+      if (special == end)
+        break;
+      writeChar(*special);
+      value = special + 1;
+    }
     writeRaw('\"');
   }
 
@@ -83,6 +94,69 @@ class TextFormatter {
     }
 #endif
 
+    writePositiveFloat(value);
+  }
+
+#if ARDUINOJSON_SHORTEST_FLOAT
+  template <typename T>
+  typename enable_if<sizeof(T) == 8>::type writePositiveFloat(T value) {
+    if (value == 0)
+      return writeRaw('0');
+
+    ShortestFloat::Decimal decimal = ShortestFloat::toDecimal(value);
+
+    // remove trailing zeros
+    while (decimal.digits % 10 == 0) {
+      decimal.digits /= 10;
+      decimal.exponent++;
+    }
+
+    // at most 17 digits
+    char buffer[20];
+    char *end = buffer + sizeof(buffer);
+    char *begin = formatInteger(decimal.digits, end);
+
+    int length = int(end - begin);
+    int exponent = decimal.exponent + length - 1;  // of the first digit
+
+    if (value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+        value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD) {
+      writeRaw(*begin);
+      if (length > 1) {
+        writeRaw('.');
+        writeRaw(begin + 1, end);
+      }
+      writeRaw('e');
+      writeInteger(exponent);
+    } else if (exponent < 0) {
+      writeRaw("0.");
+      for (int i = exponent + 1; i < 0; i++)
+        writeRaw('0');
+      writeRaw(begin, end);
+    } else if (exponent < length - 1) {
+      writeRaw(begin, begin + exponent + 1);
+      writeRaw('.');
+      writeRaw(begin + exponent + 1, end);
+    } else {
+      writeRaw(begin, end);
+      for (int i = length - 1; i < exponent; i++)
+        writeRaw('0');
+    }
+  }
+
+  template <typename T>
+  typename enable_if<sizeof(T) != 8>::type writePositiveFloat(T value) {
+    writeFloatParts(value);
+  }
+#else
+  template <typename T>
+  void writePositiveFloat(T value) {
+    writeFloatParts(value);
+  }
+#endif
+
+  template <typename T>
+  void writeFloatParts(T value) {
     FloatParts<T> parts(value);
 
     writeInteger(parts.integral);
@@ -112,15 +186,7 @@ class TextFormatter {
   typename enable_if<is_unsigned<T>::value>::type writeInteger(T value) {
     char buffer[22];
     char *end = buffer + sizeof(buffer);
-    char *begin = end;
-
-    // write the string in reverse order
-    do {
-      *--begin = char(value % 10 + '0');
-      value = T(value / 10);
-    } while (value);
-
-    // and dump it in the right order
+    char *begin = formatInteger(value, end);
     writeRaw(begin, end);
   }
 
@@ -128,16 +194,8 @@ class TextFormatter {
     // buffer should be big enough for all digits and the dot
     char buffer[16];
     char *end = buffer + sizeof(buffer);
-    char *begin = end;
-
-    // write the string in reverse order
-    while (width--) {
-      *--begin = char(value % 10 + '0');
-      value /= 10;
-    }
+    char *begin = formatDecimals(value, width, end);
     *--begin = '.';
-
-    // and dump it in the right order
     writeRaw(begin, end);
   }
 
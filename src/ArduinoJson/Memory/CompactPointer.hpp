@@ -0,0 +1,80 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/limits.hpp>
+
+#include <stddef.h>  // ptrdiff_t
+#include <stdint.h>  // int32_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A pointer to a slot or a string of the memory pool.
+// With ARDUINOJSON_COMPACT_SLOTS, it's stored as the 32-bit distance from the
+// pointer itself, so the target must be in the same pool.
+template <typename T>
+class CompactPointer {
+ public:
+  // Must be a POD!
+  // - no constructor
+  // - no destructor
+  // - no virtual
+  // - no inheritance
+
+  T* get() const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (!_offset)
+      return 0;
+    void* p = const_cast<char*>(reinterpret_cast<const char*>(this)) + _offset;
+    return static_cast<T*>(p);
+#else
+    return _ptr;
+#endif
+  }
+
+  void set(T* p) {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (!p) {
+      _offset = 0;
+      return;
+    }
+    ptrdiff_t offset =
+        reinterpret_cast<const char*>(p) - reinterpret_cast<const char*>(this);
+    ARDUINOJSON_ASSERT(offset != 0);
+    ARDUINOJSON_ASSERT(offset >= numeric_limits<int32_t>::lowest());
+    ARDUINOJSON_ASSERT(offset <= numeric_limits<int32_t>::highest());
+    _offset = int32_t(offset);
+#else
+    _ptr = p;
+#endif
+  }
+
+  // Updates the pointer after the target moved by `targetDistance` bytes, and
+  // the pointer itself by `selfDistance` bytes
+#if ARDUINOJSON_COMPACT_SLOTS
+  void move(ptrdiff_t targetDistance, ptrdiff_t selfDistance) {
+    if (_offset)
+      _offset = int32_t(_offset + targetDistance - selfDistance);
+  }
+#else
+  void move(ptrdiff_t targetDistance, ptrdiff_t) {
+    if (!_ptr)
+      return;
+    void* p = const_cast<char*>(reinterpret_cast<const char*>(_ptr)) +
+              targetDistance;
+    _ptr = static_cast<T*>(p);
+  }
+#endif
+
+ private:
+#if ARDUINOJSON_COMPACT_SLOTS
+  int32_t _offset;  // 0 means null
+#else
+  T* _ptr;
+#endif
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
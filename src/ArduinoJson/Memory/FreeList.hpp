@@ -0,0 +1,90 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // ptrdiff_t
+#include <stdint.h>  // int32_t
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A list of the free chunks of a MemoryPool.
+// Each chunk starts with the 32-bit distance to the next one, so it doesn't
+// need to be aligned, and the list remains valid when the chunks move
+// together; only the head must follow them.
+class FreeList {
+ public:
+  static const size_t linkSize = sizeof(int32_t);
+
+  FreeList() : _head(0) {}
+
+  bool empty() const {
+    return _head == 0;
+  }
+
+  char* head() const {
+    return _head;
+  }
+
+  // Returns false if `chunk` is too far from the head, in another block
+  bool push(char* chunk) {
+    if (!setNext(chunk, _head))
+      return false;
+    _head = chunk;
+    return true;
+  }
+
+  char* pop() {
+    char* chunk = _head;
+    _head = next(chunk);
+    return chunk;
+  }
+
+  // Removes the chunk that follows `prev`, or the head if `prev` is null.
+  // Returns false if the chunks around it are too far from each other.
+  bool remove(char* prev, char* chunk) {
+    if (!prev) {
+      ARDUINOJSON_ASSERT(chunk == _head);
+      pop();
+      return true;
+    }
+    return setNext(prev, next(chunk));
+  }
+
+  static char* next(const char* chunk) {
+    int32_t link;
+    memcpy(&link, chunk, linkSize);
+    return link ? const_cast<char*>(chunk) + link : 0;
+  }
+
+  void move(ptrdiff_t offset) {
+    if (_head)
+      _head += offset;
+  }
+
+  void clear() {
+    _head = 0;
+  }
+
+ private:
+  static bool setNext(char* chunk, const char* next) {
+    int32_t link = 0;
+    if (next) {
+      ptrdiff_t distance = next - chunk;
+      if (distance < -0x7FFFFFFF || distance > 0x7FFFFFFF)
+        return false;
+      link = int32_t(distance);
+    }
+    memcpy(chunk, &link, linkSize);
+    return true;
+  }
+
+  char* _head;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
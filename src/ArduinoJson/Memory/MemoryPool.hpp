@@ -5,17 +5,56 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/FreeList.hpp>
+#include <ArduinoJson/Memory/StringTable.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/mpl/max.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantSlot.hpp>
 
-#include <string.h>  // memmove
+#include <stdint.h>  // uintptr_t
+#include <string.h>  // memcpy, memmove, strlen
 
 #define JSON_STRING_SIZE(SIZE) (SIZE + 1)
 
 namespace ARDUINOJSON_NAMESPACE {
 
+#if ARDUINOJSON_COMPACT_SLOTS
+// The root variant follows the slots, so its CompactPointers can reach them
+const size_t rootVariantSize = sizeof(VariantSlot);
+// A CompactPointer stores a 32-bit distance
+const size_t maxPoolCapacity = 0x7FFF0000;
+// The distance between two slots is stored in 24 bits
+const size_t maxVariantsSize = 0x800000 * sizeof(VariantSlot);
+#else
+const size_t rootVariantSize = 0;
+#endif
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+// The removed strings are sorted by size: [5,8), [8,16), [16,32)... the last
+// list has the ones of 4 KB and more
+const size_t freeStringClasses = 11;
+// A free string contains the link to the next one, and a terminator
+const size_t minFreeStringSize = FreeList::linkSize + 1;
+#endif
+
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+// The functions that a MemoryPool calls to get extra blocks
+struct BlockAllocator {
+  void* (*allocate)(void* context, size_t size);
+  void (*deallocate)(void* context, void* ptr);
+  void* context;
+};
+
+// The header of an extra block, which saves the state of the previous block
+struct PoolBlock {
+  PoolBlock* previous;  // null if the previous block is the first one
+  PoolBlock* next;      // null for the last header
+  char *begin, *left, *right, *end;
+  bool slotsAllowed;
+};
+#endif
+
 // _begin                                   _end
 // v                                           v
 // +-------------+--------------+--------------+
@@ -23,42 +62,210 @@ namespace ARDUINOJSON_NAMESPACE {
 // +-------------+--------------+--------------+
 //               ^              ^
 //             _left          _right
+//
+// With ARDUINOJSON_COMPACT_SLOTS, the root variant is at _end, in the last
+// bytes of the buffer, which don't count in the capacity.
+//
+// With ARDUINOJSON_ENABLE_POOL_GROWTH, the pool gets extra blocks from the
+// BlockAllocator when it's full. The pointers above refer to the last block,
+// and each extra block starts with a PoolBlock that saves the previous ones.
+// The blocks never move, so the references to the variants remain valid.
 
 class MemoryPool {
  public:
   MemoryPool(char* buf, size_t capa)
       : _begin(buf),
         _left(buf),
-        _right(buf ? buf + capa : 0),
-        _end(buf ? buf + capa : 0),
-        _overflowed(false) {
+        _right(buf ? buf + capa - rootVariantSize : 0),
+        _end(buf ? buf + capa - rootVariantSize : 0),
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+        _block(0),
+        _firstBlock(0),
+        _slotsAllowed(true),
+#endif
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+        _strings(0),
+        _stringCount(0),
+#endif
+        _overflowed(false),
+        _frozen(false) {
+    ARDUINOJSON_ASSERT(!buf || capa >= rootVariantSize);
     ARDUINOJSON_ASSERT(isAligned(_begin));
     ARDUINOJSON_ASSERT(isAligned(_right));
     ARDUINOJSON_ASSERT(isAligned(_end));
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    _allocator.allocate = 0;
+    _allocator.deallocate = 0;
+    _allocator.context = 0;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  // Allows the pool to grow; the caller must set it again if the pool moves
+  // to another owner
+  void setAllocator(const BlockAllocator& allocator) {
+    _allocator = allocator;
+  }
+
+  // Gets the capacity of a pool that can grow.
+  // The extra blocks have the size of the first one, so the allocator is
+  // likely to put them in the same area, where the slots can be linked; this
+  // size must leave room for a PoolBlock and a few slots.
+  static size_t growableCapacity(size_t capa) {
+    const size_t minCapa = sizeof(PoolBlock) + 4 * sizeof(VariantSlot);
+    return capa < minCapa ? minCapa : capa;
   }
 
+#endif
+
+  bool hasExtraBlocks() const {
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    return _block != 0;
+#else
+    return false;
+#endif
+  }
+
+  // Gets the number of bytes of the buffer of a pool with the specified
+  // capacity
+  static size_t bufferSize(size_t capa) {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (capa > maxPoolCapacity)
+      capa = maxPoolCapacity;
+#endif
+    return capa + rootVariantSize;
+  }
+
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Gets the slot of the root variant, null if the pool has no buffer
+  VariantSlot* root() {
+    void* p = _end;
+    return static_cast<VariantSlot*>(p);
+  }
+#endif
+
   void* buffer() {
+    ARDUINOJSON_ASSERT(!hasExtraBlocks());
     return _begin;  // NOLINT(clang-analyzer-unix.Malloc)
                     // movePointers() alters this pointer
   }
 
   // Gets the capacity of the memoryPool in bytes
   size_t capacity() const {
-    return size_t(_end - _begin);
+    size_t total = size_t(_end - _begin);
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    for (const PoolBlock* b = _block; b; b = b->previous)
+      total += size_t(b->end - b->begin);
+#endif
+    return total;
   }
 
   size_t size() const {
-    return size_t(_left - _begin + _end - _right);
+    size_t total = size_t(_left - _begin + _end - _right);
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    for (const PoolBlock* b = _block; b; b = b->previous)
+      total += size_t(b->left - b->begin + b->end - b->right);
+#endif
+    return total;
   }
 
   bool overflowed() const {
     return _overflowed;
   }
 
+  // Marks the pool as read-only until clear(), so several threads can read
+  // the document at the same time.
+  // Only checked by ARDUINOJSON_ASSERT(), so a debug build catches the writes.
+  void freeze() {
+    _frozen = true;
+  }
+
+  bool frozen() const {
+    return _frozen;
+  }
+
   VariantSlot* allocVariant() {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    ARDUINOJSON_ASSERT(!_frozen);
+    if (!_freeSlots.empty())
+      return slotAt(_freeSlots.pop());
+#endif
     return allocRight<VariantSlot>();
   }
 
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // Gives back a removed slot, with its children and their strings
+  // (defined in MemoryPoolImpl.hpp)
+  void freeVariant(VariantSlot* slot);
+
+  // Gives back a table that allocIndex() returned
+  void freeIndex(void* p, size_t bytes) {
+    ARDUINOJSON_ASSERT(!_frozen);
+    char* cell = static_cast<char*>(p);
+    if (!slotsAllowedAt(cell))  // the cells can't be slots, they are lost
+      return;
+    for (size_t i = 0; i < indexSize(bytes); i += sizeof(VariantSlot))
+      freeSlot(cell + i);
+  }
+
+#  if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  void freeString(const char*, size_t) {}  // it may be shared
+#  else
+  // Gives back the `n` bytes of a string that's no longer used
+  void freeString(const char* s, size_t n) {
+    ARDUINOJSON_ASSERT(!_frozen);
+    char* chunk = const_cast<char*>(s);
+    if (chunk + n == _left) {
+      _left = chunk;
+      return;
+    }
+    if (n < minFreeStringSize || !owns(s))
+      return;
+    // the free string must end with the only terminator
+    memset(chunk + FreeList::linkSize, 1, n - FreeList::linkSize - 1);
+    chunk[n - 1] = 0;
+    _freeStrings[freeStringClass(n)].push(chunk);
+  }
+#  endif
+#else
+  void freeVariant(VariantSlot*) {}
+#endif
+
+  // Unlike the other allocations, a CollectionIndex or a StringTable is
+  // optional, so the pool is not marked as overflowed if there is no room for
+  // it
+  void* allocIndex(size_t bytes) {
+    ARDUINOJSON_ASSERT(!_frozen);
+    bytes = indexSize(bytes);
+    if (!canAllocRight(bytes) && !(grow(bytes) && canAllocRight(bytes)))
+      return 0;
+    _right -= bytes;
+    return _right;
+  }
+
+  // Gets the number of bytes that allocIndex() takes from the pool
+  static size_t indexSize(size_t bytes) {
+    // VariantSlot::_next is a distance in slots, so everything on the right
+    // must be a multiple of the slot size
+    const size_t slotSize = sizeof(VariantSlot);
+    return (bytes + slotSize - 1) / slotSize * slotSize;
+  }
+
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+  // Gets the number of bytes of the string tables, once the pool contains
+  // `count` strings
+  static size_t stringTableMemoryUsage(size_t count) {
+    size_t total = 0;
+    if (count < stringTableThreshold)
+      return 0;
+    for (size_t capacity = 4 * stringTableThreshold;; capacity *= 2) {
+      total += indexSize(StringTable::sizeFor(capacity));
+      if (2 * count <= capacity)
+        return total;
+    }
+  }
+#endif
+
   template <typename TAdaptedString>
   const char* saveString(TAdaptedString str) {
     if (str.isNull())
@@ -76,6 +283,9 @@ class MemoryPool {
     if (newCopy) {
       stringGetChars(str, newCopy, n);
       newCopy[n] = 0;  // force null-terminator
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION && ARDUINOJSON_ENABLE_STRING_TABLE
+      addToStringTable(newCopy, n);
+#endif
     }
     return newCopy;
   }
@@ -85,17 +295,76 @@ class MemoryPool {
     *zoneSize = size_t(_right - _left);
   }
 
+  void getStrings(const char** start, size_t* size) const {
+    *start = _begin;
+    *size = size_t(_left - _begin);
+  }
+
+  void getVariants(const char** start, size_t* size) const {
+    *start = _right;
+    *size = size_t(_end - _right);
+  }
+
+  // Takes the strings and the variants of a snapshot from an empty pool.
+  // The caller fills the two zones.
+  bool allocSnapshot(size_t stringsSize, size_t variantsSize, char** strings,
+                     char** variants) {
+    ARDUINOJSON_ASSERT(_left == _begin && _right == _end);
+    ARDUINOJSON_ASSERT(variantsSize % sizeof(VariantSlot) == 0);
+    size_t capa = size_t(_end - _begin);
+    if (stringsSize > capa || variantsSize > capa - stringsSize)
+      return false;
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (variantsSize > maxVariantsSize)
+      return false;
+#endif
+    _left = _begin + stringsSize;
+    _right = _end - variantsSize;
+    *strings = _begin;
+    *variants = _right;
+    return true;
+  }
+
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  // Moves the string being written in the free zone to a new block, where the
+  // free zone is at least `required` bytes
+  bool growFreeZone(char** zoneStart, size_t* zoneSize, size_t used,
+                    size_t required) {
+    ARDUINOJSON_ASSERT(*zoneStart == _left);
+    // double the size, so a long string doesn't need a new block for every
+    // character
+    if (!grow(2 * required))
+      return false;
+    memcpy(_left, *zoneStart, used);
+    getFreeZone(zoneStart, zoneSize);
+    return true;
+  }
+#endif
+
   const char* saveStringFromFreeZone(size_t len) {
+    ARDUINOJSON_ASSERT(!_frozen);
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
     const char* dup = findString(adaptString(_left, len));
     if (dup)
       return dup;
 #endif
 
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    char* chunk = takeFreeString(len + 1);
+    if (chunk) {
+      memcpy(chunk, _left, len);
+      chunk[len] = 0;
+      return chunk;
+    }
+#endif
+
     const char* str = _left;
     _left += len;
     *_left++ = 0;
     checkInvariants();
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION && ARDUINOJSON_ENABLE_STRING_TABLE
+    addToStringTable(str, len);
+#endif
     return str;
   }
 
@@ -104,16 +373,47 @@ class MemoryPool {
   }
 
   void clear() {
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    while (_block) {
+      PoolBlock* block = _block;
+      _begin = block->begin;
+      _end = block->end;
+      _block = block->previous;
+      _allocator.deallocate(_allocator.context, block);
+    }
+    _firstBlock = 0;
+    _slotsAllowed = true;
+#endif
     _left = _begin;
     _right = _end;
     _overflowed = false;
+    _frozen = false;
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+    _strings = 0;
+    _stringCount = 0;
+#endif
+    clearFreeLists();
   }
 
   bool canAlloc(size_t bytes) const {
     return _left + bytes <= _right;
   }
 
-  bool owns(void* p) const {
+  bool canAllocRight(size_t bytes) const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    if (size_t(_end - _right) + bytes > maxVariantsSize)
+      return false;
+#endif
+    return canAlloc(bytes);
+  }
+
+  bool owns(const void* p) const {
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+    for (const PoolBlock* b = _block; b; b = b->previous) {
+      if (b->begin <= p && p < b->end)
+        return true;
+    }
+#endif
     return _begin <= p && p < _end;
   }
 
@@ -134,26 +434,83 @@ class MemoryPool {
   //
   // This funcion is called before a realloc.
   ptrdiff_t squash() {
+    ARDUINOJSON_ASSERT(!hasExtraBlocks());
+    ARDUINOJSON_ASSERT(!_frozen);
     char* new_right = addPadding(_left);
     if (new_right >= _right)
       return 0;
 
     size_t right_size = static_cast<size_t>(_end - _right);
-    memmove(new_right, _right, right_size);
+    memmove(new_right, _right, right_size + rootVariantSize);
 
     ptrdiff_t bytes_reclaimed = _right - new_right;
     _right = new_right;
     _end = new_right + right_size;
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    _freeSlots.move(-bytes_reclaimed);
+#endif
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+    if (_strings)
+      _strings = reinterpret_cast<StringTable*>(
+          reinterpret_cast<char*>(_strings) - bytes_reclaimed);
+#endif
     return bytes_reclaimed;
   }
 
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Gets the number of bytes that copySquashed() writes
+  size_t squashedSize() const {
+    return addPadding(size_t(_left - _begin)) + size_t(_end - _right);
+  }
+
+  // Copies the strings and the variants without the free space between them.
+  // The caller must fix the CompactPointers of the copy with the distances
+  // that the strings and the variants moved.
+  void copySquashed(char* dst, ptrdiff_t* stringDistance,
+                    ptrdiff_t* variantDistance) const {
+    size_t stringsSize = size_t(_left - _begin);
+    size_t paddedSize = addPadding(stringsSize);
+    size_t variantsSize = size_t(_end - _right);
+    if (stringsSize)
+      memcpy(dst, _begin, stringsSize);
+    memset(dst + stringsSize, 0, paddedSize - stringsSize);
+    if (variantsSize)
+      memcpy(dst + paddedSize, _right, variantsSize);
+    *stringDistance = _begin ? dst - _begin : 0;
+    *variantDistance = _right ? dst + paddedSize - _right : 0;
+  }
+#endif
+
+  // Moves the live variants and strings to the ends of the buffer, in place,
+  // so the space of the removed values can be used again.
+  // (defined in MemoryPoolImpl.hpp)
+  void compact(VariantData& root);
+
   // Move all pointers together
   // This funcion is called after a realloc.
   void movePointers(ptrdiff_t offset) {
+    ARDUINOJSON_ASSERT(!hasExtraBlocks());
     _begin += offset;
     _left += offset;
     _right += offset;
     _end += offset;
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    _freeSlots.move(offset);
+#  if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    for (size_t i = 0; i < freeStringClasses; i++)
+      _freeStrings[i].move(offset);
+#  endif
+#endif
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+    if (_strings) {
+      _strings = reinterpret_cast<StringTable*>(
+          reinterpret_cast<char*>(_strings) + offset);
+      for (size_t i = 0; i < _strings->capacity; i++) {
+        if (_strings->buckets[i])
+          _strings->buckets[i] += offset;
+      }
+    }
+#endif
   }
 
  private:
@@ -164,11 +521,133 @@ class MemoryPool {
     ARDUINOJSON_ASSERT(isAligned(_right));
   }
 
+  void clearFreeLists() {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    _freeSlots.clear();
+#  if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    for (size_t i = 0; i < freeStringClasses; i++)
+      _freeStrings[i].clear();
+#  endif
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  void freeSlot(char* p) {
+    if (p == _right) {
+      _right += sizeof(VariantSlot);
+      return;
+    }
+    _freeSlots.push(p);  // a slot too far from the others is lost
+  }
+
+#  if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  static size_t freeStringClass(size_t n) {
+    size_t i = 0;
+    while (i + 1 < freeStringClasses && n >= size_t(8) << i)
+      i++;
+    return i;
+  }
+
+  static size_t freeStringSize(const char* chunk) {
+    return FreeList::linkSize + strlen(chunk + FreeList::linkSize) + 1;
+  }
+
+  // Takes a string of the same size, or one that leaves enough bytes to make
+  // another free string, or else one that is just large enough; the bytes that
+  // remain in the last case are lost until compact().
+  // Only the first strings of each list are considered, to bound the cost.
+  char* takeFreeString(size_t n) {
+    const int maxCandidates = 8;
+    for (size_t i = freeStringClass(n); i < freeStringClasses; i++) {
+      FreeList& list = _freeStrings[i];
+      char *best = 0, *bestPrev = 0;
+      size_t bestSize = 0;
+      char* prev = 0;
+      char* chunk = list.head();
+      for (int j = 0; chunk && j < maxCandidates; j++) {
+        size_t size = freeStringSize(chunk);
+        bool clean = size == n || size >= n + minFreeStringSize;
+        if (size >= n && (clean || !best)) {
+          best = chunk;
+          bestPrev = prev;
+          bestSize = size;
+          if (clean)
+            break;
+        }
+        prev = chunk;
+        chunk = FreeList::next(chunk);
+      }
+      if (!best || !list.remove(bestPrev, best))
+        continue;
+      if (bestSize > n)
+        freeString(best + n, bestSize - n);
+      return best;
+    }
+    return 0;
+  }
+#  endif
+#endif
+
+  static VariantSlot* slotAt(char* p) {
+    void* slot = p;
+    return static_cast<VariantSlot*>(slot);
+  }
+
+  // Dead slots and tables can have any flags
+  void unmarkSlots() {
+    for (char* p = _right; p < _end; p += sizeof(VariantSlot))
+      slotAt(p)->unmark();
+  }
+
+  // Moves the marked slots below `boundary` to the unmarked cells above it,
+  // and writes their new address in their old cell
+  void moveMarkedSlots(char* boundary) {
+    VariantSlot* dst = slotAt(boundary);
+    for (char* p = _right; p < boundary; p += sizeof(VariantSlot)) {
+      VariantSlot* src = slotAt(p);
+      if (!src->isMarked())
+        continue;
+      while (dst->isMarked())
+        dst++;
+      *dst = *src;
+      dst->relocate(reinterpret_cast<char*>(dst) - p);
+      memcpy(p, &dst, sizeof(dst));
+      dst++;
+    }
+  }
+
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
   template <typename TAdaptedString>
   const char* findString(const TAdaptedString& str) const {
+#  if ARDUINOJSON_ENABLE_STRING_TABLE
+    if (_strings) {
+      size_t n = str.size();
+      size_t mask = _strings->capacity - 1;
+      for (size_t i = stringHash(str) & mask;; i = (i + 1) & mask) {
+        const char* s = _strings->buckets[i];
+        if (!s)
+          return 0;
+        if (strlen(s) == n && stringEquals(str, adaptString(s, n)))
+          return s;
+      }
+    }
+#  endif
+#  if ARDUINOJSON_ENABLE_POOL_GROWTH
+    // oldest first, like a single block
+    for (const PoolBlock* b = _firstBlock; b; b = b->next) {
+      const char* found = findString(str, b->begin, b->left);
+      if (found)
+        return found;
+    }
+#  endif
+    return findString(str, _begin, _left);
+  }
+
+  template <typename TAdaptedString>
+  static const char* findString(const TAdaptedString& str, char* begin,
+                                char* left) {
     size_t n = str.size();
-    for (char* next = _begin; next + n < _left; ++next) {
+    for (char* next = begin; next + n < left; ++next) {
       if (next[n] == '\0' && stringEquals(str, adaptString(next, n)))
         return next;
 
@@ -179,8 +658,84 @@ class MemoryPool {
   }
 #endif
 
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+  // Number of strings from which the pool gets a table
+  static const size_t stringTableThreshold = 32;
+
+  void addToStringTable(const char* s, size_t n) {
+    _stringCount++;
+    if (!_strings) {
+      // Only try once, so a full pool doesn't cost a scan for every string
+      if (_stringCount == stringTableThreshold)
+        buildStringTable(4 * stringTableThreshold);
+      return;
+    }
+    if (_strings->isFull())
+      return buildStringTable(2 * _strings->capacity);  // includes s
+    insertInStringTable(s, n);
+  }
+
+  // Replaces the table with a larger one.
+  // The old table stays in the pool, like the removed slots.
+  void buildStringTable(size_t capacity) {
+    void* p = allocIndex(StringTable::sizeFor(capacity));
+    if (!p) {
+      // Fall back to the linear search, as the old table is full
+      _strings = 0;
+      return;
+    }
+    _strings = static_cast<StringTable*>(p);
+    _strings->count = 0;
+    _strings->capacity = capacity;
+    for (size_t i = 0; i < capacity; i++)
+      _strings->buckets[i] = 0;
+    insertStringsInTable(_begin, _left);
+#  if ARDUINOJSON_ENABLE_POOL_GROWTH
+    for (const PoolBlock* b = _block; b; b = b->previous)
+      insertStringsInTable(b->begin, b->left);
+#  endif
+  }
+
+  void rebuildStringTable() {
+    size_t count = 0;
+    for (const char* s = _begin; s < _left; s += strlen(s) + 1)
+      count++;
+    _stringCount = count;
+    if (count < stringTableThreshold)
+      return;
+    size_t capacity = 4 * stringTableThreshold;
+    while (2 * (count + 1) > capacity)
+      capacity *= 2;
+    buildStringTable(capacity);
+  }
+
+  void insertStringsInTable(const char* begin, const char* left) {
+    for (const char* s = begin; s < left; s += strlen(s) + 1) {
+      if (_strings->isFull())  // strings with a '\0' inside count twice
+        break;
+      insertInStringTable(s, strlen(s));
+    }
+  }
+
+  void insertInStringTable(const char* s, size_t n) {
+    ARDUINOJSON_ASSERT(!_strings->isFull());
+    size_t mask = _strings->capacity - 1;
+    size_t i = stringHash(adaptString(s, n)) & mask;
+    while (_strings->buckets[i])
+      i = (i + 1) & mask;
+    _strings->buckets[i] = s;
+    _strings->count++;
+  }
+#endif
+
   char* allocString(size_t n) {
-    if (!canAlloc(n)) {
+    ARDUINOJSON_ASSERT(!_frozen);
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    char* chunk = takeFreeString(n);
+    if (chunk)
+      return chunk;
+#endif
+    if (!canAlloc(n) && !grow(n)) {
       _overflowed = true;
       return 0;
     }
@@ -196,7 +751,8 @@ class MemoryPool {
   }
 
   void* allocRight(size_t bytes) {
-    if (!canAlloc(bytes)) {
+    ARDUINOJSON_ASSERT(!_frozen);
+    if (!canAllocSlots(bytes) && !(grow(bytes) && canAllocSlots(bytes))) {
       _overflowed = true;
       return 0;
     }
@@ -204,8 +760,140 @@ class MemoryPool {
     return _right;
   }
 
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  bool canAllocSlots(size_t bytes) const {
+    return _slotsAllowed && canAllocRight(bytes);
+  }
+
+  // Tells whether the block that contains p can hold slots
+  bool slotsAllowedAt(const char* p) const {
+    for (const PoolBlock* b = _block; b; b = b->previous) {
+      if (b->begin <= p && p < b->end)
+        return b->slotsAllowed;
+    }
+    return _slotsAllowed;
+  }
+
+  // Starts a new block with at least `bytes` of free space
+  bool grow(size_t bytes) {
+    if (!_allocator.allocate)
+      return false;
+
+    // Give the extra blocks the size of the first one, so the allocator is
+    // likely to take them from the same area (only a bigger string gets a
+    // bigger block)
+    const size_t slotSize = sizeof(VariantSlot);
+    size_t blockSize = firstBlockSize();
+    size_t minSize = sizeof(PoolBlock) + slotSize + (bytes > 0 ? bytes : 1);
+    if (blockSize < minSize)
+      blockSize = minSize;
+
+    char* raw =
+        static_cast<char*>(_allocator.allocate(_allocator.context, blockSize));
+    if (!raw)
+      return false;
+
+    char* begin = raw + sizeof(PoolBlock);
+    // VariantSlot::_next is a distance in slots, so the slots of all the
+    // blocks must be a whole number of slots apart, and not too far.
+    // If the block is too far, we only use it for strings.
+    char* end = raw + blockSize;
+    end -= modulo(end, _end, slotSize);
+    bool slotsAllowed = isReachable(begin, end);
+
+    PoolBlock* block = reinterpret_cast<PoolBlock*>(raw);
+    block->previous = _block;
+    block->next = 0;
+    if (_block)
+      _block->next = block;
+    else
+      _firstBlock = block;
+    block->begin = _begin;
+    block->left = _left;
+    block->right = _right;
+    block->end = _end;
+    block->slotsAllowed = _slotsAllowed;
+    _block = block;
+
+    _begin = _left = begin;
+    _right = _end = end;
+    _slotsAllowed = slotsAllowed;
+    checkInvariants();
+    return true;
+  }
+
+  size_t firstBlockSize() const {
+    if (!_firstBlock)
+      return size_t(_end - _begin);
+    return size_t(_firstBlock->end - _firstBlock->begin);
+  }
+
+  // (a - b) % n, for pointers that may belong to different blocks
+  static size_t modulo(const char* a, const char* b, size_t n) {
+    uintptr_t x = reinterpret_cast<uintptr_t>(a);
+    uintptr_t y = reinterpret_cast<uintptr_t>(b);
+    size_t r = size_t((x >= y ? x - y : y - x) % n);
+    return x >= y || r == 0 ? r : n - r;
+  }
+
+  // Tells whether slots in [begin, end) can be linked to the slots of the
+  // other blocks
+  bool isReachable(const char* begin, const char* end) const {
+    if (_slotsAllowed && !isReachable(begin, end, _right, _end))
+      return false;
+    for (const PoolBlock* b = _block; b; b = b->previous) {
+      if (b->slotsAllowed && !isReachable(begin, end, b->right, b->end))
+        return false;
+    }
+    return true;
+  }
+
+  static bool isReachable(const char* begin, const char* end,
+                          const char* slotsBegin, const char* slotsEnd) {
+    if (slotsBegin == slotsEnd)  // no slots in this block
+      return true;
+    uintptr_t lo = reinterpret_cast<uintptr_t>(begin);
+    uintptr_t hi = reinterpret_cast<uintptr_t>(end);
+    if (reinterpret_cast<uintptr_t>(slotsBegin) < lo)
+      lo = reinterpret_cast<uintptr_t>(slotsBegin);
+    if (reinterpret_cast<uintptr_t>(slotsEnd) > hi)
+      hi = reinterpret_cast<uintptr_t>(slotsEnd);
+    return (hi - lo) / sizeof(VariantSlot) <=
+           uintptr_t(numeric_limits<VariantSlotDiff>::highest());
+  }
+#else
+  bool canAllocSlots(size_t bytes) const {
+    return canAllocRight(bytes);
+  }
+
+  bool slotsAllowedAt(const char*) const {
+    return true;
+  }
+
+  bool grow(size_t) {
+    return false;
+  }
+#endif
+
   char *_begin, *_left, *_right, *_end;
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  PoolBlock* _block;  // the header of the current block, null for the first
+  PoolBlock* _firstBlock;  // the header that saves the first block
+  BlockAllocator _allocator;
+  bool _slotsAllowed;  // false if the current block is too far from the others
+#endif
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+  StringTable* _strings;  // may be null
+  size_t _stringCount;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  FreeList _freeSlots;
+#  if !ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  FreeList _freeStrings[freeStringClasses];
+#  endif
+#endif
   bool _overflowed;
+  bool _frozen;
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,108 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Memory/StringBitmap.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+class StringMarker {
+ public:
+  StringMarker(StringBitmap& bitmap) : _bitmap(&bitmap) {}
+
+  const char* operator()(const char* s, size_t n) {
+    _bitmap->mark(s, n + 1);  // including the terminator
+    return s;
+  }
+
+ private:
+  StringBitmap* _bitmap;
+};
+
+class StringForwarder {
+ public:
+  StringForwarder(const StringBitmap& bitmap) : _bitmap(&bitmap) {}
+
+  const char* operator()(const char* s, size_t) {
+    return _bitmap->forward(s);
+  }
+
+ private:
+  const StringBitmap* _bitmap;
+};
+
+// 1. The variants: mark the live slots, move the ones that are too low to the
+//    dead cells at the top, and fix the links with the new addresses left in
+//    the old cells.
+// 2. The strings: mark the live bytes in a bitmap in the free space, fix the
+//    pointers, and slide the live bytes toward _begin.
+// 3. Rebuild the tables, which were in the way.
+inline void MemoryPool::compact(VariantData& root) {
+  ARDUINOJSON_ASSERT(!hasExtraBlocks());
+  ARDUINOJSON_ASSERT(!_frozen);
+  if (!_begin)
+    return;
+
+#if ARDUINOJSON_ENABLE_STRING_TABLE
+  _strings = 0;
+#endif
+
+  clearFreeLists();
+  unmarkSlots();
+  size_t count = root.markSlots(this);
+  char* boundary = _end - count * sizeof(VariantSlot);
+  moveMarkedSlots(boundary);
+  MovedSlots moved = {_right, boundary};
+  root.forwardSlots(moved);
+  _right = boundary;
+
+  // The bitmap may not cover all the strings in a full pool, but it gets
+  // more space as the strings get smaller
+  for (;;) {
+    size_t size = size_t(_left - _begin);
+    char* space = addPadding(_left);
+    size_t covered =
+        space < _right ? StringBitmap::coverage(size_t(_right - space)) : 0;
+    if (covered > size)
+      covered = size;
+    if (!covered)
+      break;
+
+    StringBitmap bitmap(space, _begin, covered, size);
+    StringMarker marker(bitmap);
+    root.relocateStrings(marker, this);
+    unmarkSlots();
+    bitmap.count();
+    if (!bitmap.hasDeadBytes())
+      break;
+
+    StringForwarder forwarder(bitmap);
+    root.relocateStrings(forwarder, this);
+    unmarkSlots();
+    _left = bitmap.slide();
+    if (covered == size)
+      break;
+  }
+
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  root.rebuildIndexes(this);
+#endif
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION && ARDUINOJSON_ENABLE_STRING_TABLE
+  rebuildStringTable();
+#endif
+}
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+inline void MemoryPool::freeVariant(VariantSlot* slot) {
+  ARDUINOJSON_ASSERT(!_frozen);
+  slot->release(this);
+  void* p = slot;
+  freeSlot(static_cast<char*>(p));
+}
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,130 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+#include <string.h>  // memmove, memset
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A bitmap of the live bytes of the strings of a MemoryPool, with the number
+// of live bytes before each block of 256 bytes, so it's quick to compute the
+// address of a string once the live bytes are moved together.
+// MemoryPool::compact() puts it in the free space of the pool, so it may only
+// cover the first strings.
+class StringBitmap {
+ public:
+  static const size_t bytesPerWord = 32;
+  static const size_t wordsPerBlock = 8;
+  static const size_t bytesPerBlock = bytesPerWord * wordsPerBlock;
+
+  // Gets the number of bytes of strings that a bitmap in `space` bytes covers
+  static size_t coverage(size_t space) {
+    const size_t blockSize = sizeof(size_t) + wordsPerBlock * sizeof(uint32_t);
+    size_t words = space / blockSize * wordsPerBlock;
+    size_t rest = space % blockSize;
+    if (rest > sizeof(size_t))  // a partial block
+      words += (rest - sizeof(size_t)) / sizeof(uint32_t);
+    return words * bytesPerWord;
+  }
+
+  // `space` must be aligned, and large enough to cover `covered` bytes.
+  // The bytes of [strings + covered, strings + size) are considered live.
+  StringBitmap(void* space, char* strings, size_t covered, size_t size)
+      : _strings(strings), _covered(covered), _size(size), _live(0) {
+    _wordCount = (covered + bytesPerWord - 1) / bytesPerWord;
+    _ranks = static_cast<size_t*>(space);
+    void* words = _ranks + (_wordCount + wordsPerBlock - 1) / wordsPerBlock;
+    _words = static_cast<uint32_t*>(words);
+    memset(_words, 0, _wordCount * sizeof(uint32_t));
+  }
+
+  // Marks the `n` bytes at `s` as live
+  void mark(const char* s, size_t n) {
+    if (!contains(s))
+      return;
+    size_t begin = size_t(s - _strings);
+    size_t end = begin + n < _covered ? begin + n : _covered;
+    for (size_t i = begin; i < end; i++)
+      _words[i / bytesPerWord] |= uint32_t(1) << (i % bytesPerWord);
+  }
+
+  // Counts the live bytes, once they're all marked
+  void count() {
+    _live = 0;
+    for (size_t i = 0; i < _wordCount; i++) {
+      if (i % wordsPerBlock == 0)
+        _ranks[i / wordsPerBlock] = _live;
+      _live += popcount(_words[i]);
+    }
+  }
+
+  // Tells whether the bitmap found dead bytes
+  bool hasDeadBytes() const {
+    return _live < _covered;
+  }
+
+  // Gets the address of a string once slide() is done
+  const char* forward(const char* s) const {
+    if (!contains(s))
+      return s;
+    size_t offset = size_t(s - _strings);
+    if (offset >= _covered)
+      return _strings + _live + offset - _covered;
+    size_t word = offset / bytesPerWord;
+    size_t rank = _ranks[word / wordsPerBlock];
+    for (size_t i = word / wordsPerBlock * wordsPerBlock; i < word; i++)
+      rank += popcount(_words[i]);
+    uint32_t before = (uint32_t(1) << (offset % bytesPerWord)) - 1;
+    return _strings + rank + popcount(_words[word] & before);
+  }
+
+  // Moves the live bytes together, and returns the new end of the strings
+  char* slide() const {
+    char* dst = _strings;
+    for (size_t offset = 0; offset < _covered; offset += bytesPerWord) {
+      uint32_t bits = _words[offset / bytesPerWord];
+      size_t n = _covered - offset < bytesPerWord ? _covered - offset
+                                                  : bytesPerWord;
+      if (bits == 0xFFFFFFFF) {
+        memmove(dst, _strings + offset, n);
+        dst += n;
+        continue;
+      }
+      for (size_t i = 0; bits; i++, bits >>= 1) {
+        if (bits & 1)
+          *dst++ = _strings[offset + i];
+      }
+    }
+    ARDUINOJSON_ASSERT(dst == _strings + _live);
+    memmove(dst, _strings + _covered, _size - _covered);
+    return dst + _size - _covered;
+  }
+
+ private:
+  bool contains(const char* s) const {
+    return _strings <= s && s < _strings + _size;
+  }
+
+  static size_t popcount(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return size_t((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+  }
+
+  char* _strings;
+  size_t _covered;
+  size_t _size;
+  size_t _live;  // in the covered bytes
+  size_t _wordCount;
+  size_t* _ranks;  // live bytes before each block of words
+  uint32_t* _words;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,36 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A hash table of the strings of a MemoryPool, allocated in the pool itself.
+// It uses open addressing with linear probing, and is never more than half
+// full.
+struct StringTable {
+  size_t count;            // number of strings in the table
+  size_t capacity;         // number of buckets, a power of two
+  const char* buckets[1];  // null if empty
+
+  // Must be a POD!
+  // - no constructor
+  // - no destructor
+  // - no virtual
+  // - no inheritance
+
+  static size_t sizeFor(size_t capacity) {
+    return sizeof(StringTable) + (capacity - 1) * sizeof(const char*);
+  }
+
+  bool isFull() const {
+    return 2 * (count + 1) > capacity;
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -19,8 +19,18 @@
         ARDUINOJSON_HEX_DIGIT(                                                \
             ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_USE_LONG_LONG,            \
             ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_ENABLE_STRING_DEDUPLICATION), \
-        ARDUINOJSON_HEX_DIGIT(                                                \
-            ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,              \
-            ARDUINOJSON_ENABLE_COMMENTS, ARDUINOJSON_DECODE_UNICODE))
+        ARDUINOJSON_CONCAT2(                                                  \
+            ARDUINOJSON_HEX_DIGIT(                                            \
+                ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,          \
+                ARDUINOJSON_ENABLE_COMMENTS, ARDUINOJSON_DECODE_UNICODE),     \
+            ARDUINOJSON_CONCAT2(                                              \
+                ARDUINOJSON_HEX_DIGIT(ARDUINOJSON_FAST_FLOAT,                 \
+                                      ARDUINOJSON_SHORTEST_FLOAT,             \
+                                      ARDUINOJSON_ENABLE_COLLECTION_INDEX,    \
+                                      ARDUINOJSON_CACHE_COLLECTION_SIZE),     \
+                ARDUINOJSON_HEX_DIGIT(ARDUINOJSON_ENABLE_STRING_TABLE,        \
+                                      ARDUINOJSON_ENABLE_POOL_GROWTH,         \
+                                      ARDUINOJSON_COMPACT_SLOTS,              \
+                                      ARDUINOJSON_ENABLE_FREE_LISTS))))
 
 #endif
@@ -0,0 +1,143 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FastFloat.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Conversion of double to the shortest decimal number that converts back to
+// the same double, with the Schubfach algorithm described in "The Schubfach
+// way to render doubles" by Raffaello Giulietti (2020).
+// The bounds of the rounding interval are multiplied by a 128-bit
+// approximation of 10^-k, and the digits are chosen among the (at most two)
+// candidates that fall inside.
+namespace ShortestFloat {
+
+// The double is digits * 10^exponent
+struct Decimal {
+  uint64_t digits;
+  int exponent;
+};
+
+// floor(e * log10(2)) for e in [-2620, 2620]
+inline int floorLog10Pow2(int e) {
+  return (e * 1262611) >> 22;
+}
+
+// floor(log10(3/4 * 2^e)) for e in [-2985, 2936]
+inline int floorLog10ThreeQuartersPow2(int e) {
+  return (e * 1262611 - 524031) >> 22;
+}
+
+// floor(e * log2(10)) for e in [-1233, 1233]
+inline int floorLog2Pow10(int e) {
+  return (e * 1741647) >> 19;
+}
+
+// A 128-bit value slightly above 10^k, normalized so that the most
+// significant bit is set (Schubfach needs floor(10^k * 2^n) + 1).
+// It shares the table of FastFloat, since 10^k = 5^k * 2^k.
+inline void powerOfTen(int k, uint64_t& high, uint64_t& low) {
+  high = FastFloat::powerOfFive(k, 0);
+  low = FastFloat::powerOfFive(k, 1);
+  // the table is already rounded up for k in [-27, -1]
+  if (k >= 0 || k < -27) {
+    low++;
+    if (low == 0)
+      high++;
+  }
+}
+
+// Computes g * cp / 2^128, rounded to odd
+inline uint64_t roundToOdd(uint64_t gHigh, uint64_t gLow, uint64_t cp) {
+  uint64_t xHigh, xLow, yHigh, yLow;
+  FastFloat::multiply(gLow, cp, xHigh, xLow);
+  FastFloat::multiply(gHigh, cp, yHigh, yLow);
+  uint64_t zLow = yLow + xHigh;
+  uint64_t zHigh = yHigh + (zLow < yLow);
+  return zHigh | (zLow > 1);
+}
+
+// value must be positive and finite
+inline Decimal toDecimal(double value) {
+  const int mantissaBits = 52;
+  const int exponentBias = 1075;  // 1023 + mantissaBits
+  const uint64_t hiddenBit = uint64_t(1) << mantissaBits;
+
+  uint64_t bits = alias_cast<uint64_t>(value);
+  uint64_t mantissa = bits & (hiddenBit - 1);
+  int biasedExponent = int(bits >> mantissaBits);
+
+  // value = c * 2^q
+  uint64_t c;
+  int q;
+  if (biasedExponent != 0) {
+    c = mantissa | hiddenBit;
+    q = biasedExponent - exponentBias;
+    // small integers
+    if (q <= 0 && q > -53 && (c & ((uint64_t(1) << -q) - 1)) == 0) {
+      Decimal result = {c >> -q, 0};
+      return result;
+    }
+  } else {
+    c = mantissa;
+    q = 1 - exponentBias;
+  }
+
+  // the interval is closed when c is even (round-half-to-even)
+  bool isEven = (c & 1) == 0;
+  bool lowerBoundaryIsCloser = mantissa == 0 && biasedExponent > 1;
+
+  // the value and the bounds of the rounding interval, times 4
+  uint64_t cbl = 4 * c - 2 + lowerBoundaryIsCloser;
+  uint64_t cb = 4 * c;
+  uint64_t cbr = 4 * c + 2;
+
+  int k = lowerBoundaryIsCloser ? floorLog10ThreeQuartersPow2(q)
+                                : floorLog10Pow2(q);
+  int h = q + floorLog2Pow10(-k) + 1;  // in [1, 4]
+
+  uint64_t gHigh, gLow;
+  powerOfTen(-k, gHigh, gLow);
+  uint64_t vbl = roundToOdd(gHigh, gLow, cbl << h);
+  uint64_t vb = roundToOdd(gHigh, gLow, cb << h);
+  uint64_t vbr = roundToOdd(gHigh, gLow, cbr << h);
+
+  uint64_t lower = vbl + !isEven;
+  uint64_t upper = vbr - !isEven;
+
+  uint64_t s = vb / 4;
+
+  // try with one digit less
+  if (s >= 10) {
+    uint64_t sp = s / 10;
+    bool upInside = lower <= 40 * sp;
+    bool wpInside = 40 * sp + 40 <= upper;
+    if (upInside != wpInside) {
+      Decimal result = {sp + wpInside, k + 1};
+      return result;
+    }
+  }
+
+  bool uInside = lower <= 4 * s;
+  bool wInside = 4 * s + 4 <= upper;
+  if (uInside != wInside) {
+    Decimal result = {s + wInside, k};
+    return result;
+  }
+
+  // both candidates are inside: pick the closest
+  uint64_t mid = 4 * s + 2;
+  bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+  Decimal result = {s + roundUp, k};
+  return result;
+}
+
+}  // namespace ShortestFloat
+}  // namespace ARDUINOJSON_NAMESPACE
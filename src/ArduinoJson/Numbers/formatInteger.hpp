@@ -0,0 +1,74 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/static_array.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Writes the two digits of value (less than 100) before end
+inline char* formatTwoDigits(uint32_t value, char* end) {
+  ARDUINOJSON_DEFINE_STATIC_ARRAY(char, digitPairs,
+                                  "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899");
+  *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, 2 * value + 1);
+  *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, 2 * value);
+  return end;
+}
+
+// Writes exactly width digits of value before end, with leading zeros.
+// Returns a pointer to the first digit.
+inline char* formatDecimals(uint32_t value, int width, char* end) {
+  for (; width >= 2; width -= 2) {
+    end = formatTwoDigits(value % 100, end);
+    value /= 100;
+  }
+  if (width)
+    *--end = char(value % 10 + '0');
+  return end;
+}
+
+// Writes the digits of value before end, two at a time.
+// Returns a pointer to the first digit.
+inline char* formatInteger(uint32_t value, char* end) {
+  while (value >= 100) {
+    end = formatTwoDigits(value % 100, end);
+    value /= 100;
+  }
+  if (value >= 10)
+    return formatTwoDigits(value, end);
+  *--end = char(value + '0');
+  return end;
+}
+
+template <typename T>
+inline typename enable_if<sizeof(T) <= 4, char*>::type formatInteger(
+    T value, char* end) {
+  return formatInteger(uint32_t(value), end);
+}
+
+// 64-bit divisions are slow, so we split the value in chunks of 8 digits
+template <typename T>
+inline typename enable_if<(sizeof(T) > 4), char*>::type formatInteger(
+    T value, char* end) {
+  while (value > 0xFFFFFFFF) {
+    end = formatDecimals(uint32_t(value % 100000000), 8, end);
+    value /= 100000000;
+  }
+  return formatInteger(uint32_t(value), end);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
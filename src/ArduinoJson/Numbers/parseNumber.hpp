@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Numbers/FastFloat.hpp>
 #include <ArduinoJson/Numbers/FloatTraits.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -13,6 +14,8 @@
 #include <ArduinoJson/Variant/Converter.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename A, typename B>
@@ -21,7 +24,6 @@ struct choose_largest : conditional<(sizeof(A) > sizeof(B)), A, B> {};
 inline bool parseNumber(const char* s, VariantData& result) {
   typedef FloatTraits<Float> traits;
   typedef choose_largest<traits::mantissa_type, UInt>::type mantissa_t;
-  typedef traits::exponent_type exponent_t;
 
   ARDUINOJSON_ASSERT(s != 0);
 
@@ -53,8 +55,11 @@ inline bool parseNumber(const char* s, VariantData& result) {
   if (!isdigit(*s) && *s != '.')
     return false;
 
+#if ARDUINOJSON_FAST_FLOAT
+  const char* digits = s;
+#endif
+
   mantissa_t mantissa = 0;
-  exponent_t exponent_offset = 0;
   const mantissa_t maxUint = UInt(-1);
 
   while (isdigit(*s)) {
@@ -82,6 +87,16 @@ inline bool parseNumber(const char* s, VariantData& result) {
     }
   }
 
+#if ARDUINOJSON_FAST_FLOAT
+  Float value;
+  if (!FastFloat::parseDecimal(digits, value))
+    return false;
+  result.setFloat(is_negative ? -value : value);
+  return true;
+#else
+  typedef traits::exponent_type exponent_t;
+  exponent_t exponent_offset = 0;
+
   // avoid mantissa overflow
   while (mantissa > traits::mantissa_max) {
     mantissa /= 10;
@@ -141,6 +156,79 @@ inline bool parseNumber(const char* s, VariantData& result) {
 
   result.setFloat(is_negative ? -final_result : final_result);
   return true;
+#endif
+}
+
+#if ARDUINOJSON_LITTLE_ENDIAN && defined(__SIZEOF_POINTER__) && \
+    __SIZEOF_POINTER__ >= 8
+// Tells whether the 8 bytes are all decimal digits
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0U) |
+          (((chunk + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4)) ==
+         0x3333333333333333U;
+}
+
+// Converts 8 digits to an integer, the first digit being in the lowest byte
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  chunk = ((chunk & 0x0F0F0F0F0F0F0F0FU) * 2561) >> 8;   // pairs
+  chunk = ((chunk & 0x00FF00FF00FF00FFU) * 6553601) >> 16;  // quads
+  return uint32_t(((chunk & 0x0000FFFF0000FFFFU) * 42949672960001U) >> 32);
+}
+#endif
+
+// Parses an integer directly from a contiguous buffer, so the caller doesn't
+// have to copy the token first.
+// Returns a pointer to the character that follows the integer, or null if
+// the token is not a plain integer that fits in Integer or UInt (a float, for
+// example); in that case, the result is left untouched and the caller must
+// fall back to parseNumber().
+inline const char* parseInteger(const char* s, const char* end,
+                                bool (*canBeInToken)(char),
+                                VariantData& result) {
+  // 9 digits always fit in 32 bits, 19 digits in 64 bits
+  const ptrdiff_t maxDigits = sizeof(UInt) >= 8 ? 19 : 9;
+
+  bool is_negative = s < end && *s == '-';
+  if (is_negative)
+    s++;
+
+  const char* digits = s;
+  UInt value = 0;
+#if ARDUINOJSON_LITTLE_ENDIAN && defined(__SIZEOF_POINTER__) && \
+    __SIZEOF_POINTER__ >= 8
+  while (end - s >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, s, 8);
+    if (!isEightDigits(chunk))
+      break;
+    value = value * 100000000 + parseEightDigits(chunk);
+    s += 8;
+    if (s - digits > maxDigits)
+      return 0;
+  }
+#endif
+  while (s < end && isdigit(*s)) {
+    value = value * 10 + UInt(*s - '0');
+    s++;
+  }
+
+  ptrdiff_t n = s - digits;
+  if (n == 0 || n > maxDigits)
+    return 0;
+
+  // a fraction, an exponent, or garbage
+  if (s < end && canBeInToken(*s))
+    return 0;
+
+  if (is_negative) {
+    const UInt sintMax = UInt(1) << (sizeof(Integer) * 8 - 1);
+    if (value > sintMax)
+      return 0;
+    result.setInteger(Integer(~value + 1));
+  } else {
+    result.setInteger(value);
+  }
+  return s;
 }
 
 template <typename T>
@@ -17,9 +17,9 @@ inline VariantData *objectGetMember(const CollectionData *obj,
 }
 
 template <typename TAdaptedString>
-void objectRemove(CollectionData *obj, TAdaptedString key) {
+void objectRemove(CollectionData *obj, TAdaptedString key, MemoryPool *pool) {
   if (!obj)
     return;
-  obj->removeMember(key);
+  obj->removeMember(key, pool);
 }
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -154,6 +154,7 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   }
 
   void clear() const {
+    ARDUINOJSON_ASSERT(!_pool || !_pool->frozen());
     if (!_data)
       return;
     _data->clear();
@@ -172,14 +173,14 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   FORCE_INLINE void remove(iterator it) const {
     if (!_data)
       return;
-    _data->removeSlot(it.internal());
+    _data->removeSlot(it.internal(), _pool);
   }
 
   // remove(const std::string&) const
   // remove(const String&) const
   template <typename TString>
   FORCE_INLINE void remove(const TString& key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
   // remove(char*) const
@@ -187,7 +188,7 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   // remove(const __FlashStringHelper*) const
   template <typename TChar>
   FORCE_INLINE void remove(TChar* key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
  protected:
@@ -15,6 +15,11 @@ typename enable_if<is_pointer<T>::value, T>::type pgm_read(const void* p) {
   return reinterpret_cast<T>(pgm_read_ptr(p));
 }
 
+template <typename T>
+typename enable_if<is_same<T, char>::value, T>::type pgm_read(const void* p) {
+  return static_cast<char>(pgm_read_byte(p));
+}
+
 template <typename T>
 typename enable_if<is_same<T, uint32_t>::value, T>::type pgm_read(
     const void* p) {
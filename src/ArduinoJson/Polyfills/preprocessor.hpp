@@ -10,6 +10,9 @@
                              q, r)                                           \
   a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r
 
+#define ARDUINOJSON_STRINGIFY_VALUE_(A) #A
+#define ARDUINOJSON_STRINGIFY_VALUE(A) ARDUINOJSON_STRINGIFY_VALUE_(A)
+
 #define ARDUINOJSON_CONCAT_(A, B) A##B
 #define ARDUINOJSON_CONCAT2(A, B) ARDUINOJSON_CONCAT_(A, B)
 #define ARDUINOJSON_CONCAT4(A, B, C, D) \
@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Namespace.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StaticStringWriter {
@@ -20,12 +22,12 @@ class StaticStringWriter {
   }
 
   size_t write(const uint8_t *s, size_t n) {
-    char *begin = p;
-    while (p < end && n > 0) {
-      *p++ = static_cast<char>(*s++);
-      n--;
-    }
-    return size_t(p - begin);
+    size_t available = size_t(end - p);
+    if (n > available)
+      n = available;
+    memcpy(p, s, n);
+    p += n;
+    return n;
   }
 
  private:
@@ -15,7 +15,7 @@ class StringCopier {
   void startString() {
     _pool->getFreeZone(&_ptr, &_capacity);
     _size = 0;
-    if (_capacity == 0)
+    if (_capacity == 0 && !grow(0))
       _pool->markAsOverflowed();
   }
 
@@ -30,11 +30,16 @@ class StringCopier {
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0) append(*s++);
+    if (_size + n < _capacity || grow(n)) {
+      memcpy(_ptr + _size, s, n);
+      _size += n;
+    } else {
+      _pool->markAsOverflowed();
+    }
   }
 
   void append(char c) {
-    if (_size + 1 < _capacity)
+    if (_size + 1 < _capacity || grow(1))
       _ptr[_size++] = c;
     else
       _pool->markAsOverflowed();
@@ -56,6 +61,17 @@ class StringCopier {
   }
 
  private:
+#if ARDUINOJSON_ENABLE_POOL_GROWTH
+  // Makes room for n more characters and the terminator
+  bool grow(size_t n) {
+    return _pool->growFreeZone(&_ptr, &_capacity, _size, _size + n + 1);
+  }
+#else
+  bool grow(size_t) {
+    return false;
+  }
+#endif
+
   MemoryPool* _pool;
 
   // These fields aren't initialized by the constructor but startString()
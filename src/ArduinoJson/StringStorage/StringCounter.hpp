@@ -0,0 +1,53 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+#include <ArduinoJson/StringStorage/StringMover.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Measures the strings instead of storing them.
+// It's built from the storage that the parser would use, to know whether the
+// strings go in the pool.
+class StringCounter {
+ public:
+  explicit StringCounter(const StringCopier&) : _copied(true), _size(0) {}
+  explicit StringCounter(const StringMover&) : _copied(false), _size(0) {}
+
+  void startString() {
+    _size = 0;
+  }
+
+  void append(const char* s) {
+    while (*s++) _size++;
+  }
+
+  void append(const char*, size_t n) {
+    _size += n;
+  }
+
+  void append(char) {
+    _size++;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  // Gets the number of bytes that the string takes in the pool
+  size_t storageSize() const {
+    return _copied ? _size + 1 : 0;
+  }
+
+ private:
+  bool _copied;
+  size_t _size;
+};
+}  // namespace ARDUINOJSON_NAMESPACE
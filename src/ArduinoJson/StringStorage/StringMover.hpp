@@ -7,6 +7,8 @@
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/String.hpp>
 
+#include <string.h>  // memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringMover {
@@ -27,6 +29,12 @@ class StringMover {
     *_writePtr++ = c;
   }
 
+  // The source can overlap the destination since we write in the input buffer
+  void append(const char* s, size_t n) {
+    memmove(_writePtr, s, n);
+    _writePtr += n;
+  }
+
   bool isValid() const {
     return true;
   }
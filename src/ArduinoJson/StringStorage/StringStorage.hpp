@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/StringStorage/StringCopier.hpp>
+#include <ArduinoJson/StringStorage/StringCounter.hpp>
 #include <ArduinoJson/StringStorage/StringMover.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -14,10 +15,12 @@ StringCopier makeStringStorage(TInput&, MemoryPool& pool) {
   return StringCopier(pool);
 }
 
+#if !ARDUINOJSON_COMPACT_SLOTS  // a CompactPointer can't point to the input
 template <typename TChar>
 StringMover makeStringStorage(
     TChar* input, MemoryPool&,
     typename enable_if<!is_const<TChar>::value>::type* = 0) {
   return StringMover(reinterpret_cast<char*>(input));
 }
+#endif
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -45,6 +45,16 @@ inline CopyStringStoragePolicy getStringStoragePolicy(const T &) {
   return CopyStringStoragePolicy();
 }
 
+#if ARDUINOJSON_COMPACT_SLOTS
+// A CompactPointer can't point outside of the pool
+inline CopyStringStoragePolicy getStringStoragePolicy(const char *) {
+  return CopyStringStoragePolicy();
+}
+
+inline CopyStringStoragePolicy getStringStoragePolicy(const String &) {
+  return CopyStringStoragePolicy();
+}
+#else
 inline LinkStringStoragePolicy getStringStoragePolicy(const char *) {
   return LinkStringStoragePolicy();
 }
@@ -52,5 +62,6 @@ inline LinkStringStoragePolicy getStringStoragePolicy(const char *) {
 inline LinkOrCopyStringStoragePolicy getStringStoragePolicy(const String &s) {
   return LinkOrCopyStringStoragePolicy(s.isLinked());
 }
+#endif
 
 }  // namespace ARDUINOJSON_NAMESPACE
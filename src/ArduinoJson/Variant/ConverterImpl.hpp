@@ -164,8 +164,14 @@ template <>
 struct Converter<SerializedValue<const char*> > {
   static void toJson(SerializedValue<const char*> src, VariantRef dst) {
     VariantData* data = VariantAttorney::getData(dst);
-    if (data)
-      data->setLinkedRaw(src);
+    if (!data)
+      return;
+#if ARDUINOJSON_COMPACT_SLOTS
+    // A CompactPointer can't point outside of the pool
+    data->storeOwnedRaw(src, VariantAttorney::getPool(dst));
+#else
+    data->setLinkedRaw(src);
+#endif
   }
 };
 
@@ -7,6 +7,7 @@
 #include <stddef.h>  // size_t
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Memory/CompactPointer.hpp>
 #include <ArduinoJson/Numbers/Float.hpp>
 #include <ArduinoJson/Numbers/Integer.hpp>
 
@@ -31,6 +32,9 @@ enum {
   VALUE_IS_SIGNED_INTEGER = 0x0A,
   VALUE_IS_FLOAT = 0x0C,
 
+  // Only set while MemoryPool::compact() visits the slots
+  SLOT_MARK_BIT = 0x10,
+
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
   VALUE_IS_ARRAY = 0x40,
@@ -38,6 +42,12 @@ enum {
   OWNED_KEY_BIT = 0x80
 };
 
+#if ARDUINOJSON_COMPACT_SLOTS
+typedef uint32_t StringSize;  // the pool is smaller than 4 GB
+#else
+typedef size_t StringSize;
+#endif
+
 struct RawData {
   const char *data;
   size_t size;
@@ -50,8 +60,8 @@ union VariantContent {
   Integer asSignedInteger;
   CollectionData asCollection;
   struct {
-    const char *data;
-    size_t size;
+    CompactPointer<const char> data;
+    StringSize size;
   } asString;
 };
 }  // namespace ARDUINOJSON_NAMESPACE
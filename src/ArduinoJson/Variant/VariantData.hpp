@@ -56,12 +56,12 @@ class VariantData {
 
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
-        return visitor.visitString(_content.asString.data,
+        return visitor.visitString(_content.asString.data.get(),
                                    _content.asString.size);
 
       case VALUE_IS_OWNED_RAW:
       case VALUE_IS_LINKED_RAW:
-        return visitor.visitRawJson(_content.asString.data,
+        return visitor.visitRawJson(_content.asString.data.get(),
                                     _content.asString.size);
 
       case VALUE_IS_SIGNED_INTEGER:
@@ -156,15 +156,15 @@ class VariantData {
     return !isFloat();
   }
 
-  void remove(size_t index) {
+  void remove(size_t index, MemoryPool *pool) {
     if (isArray())
-      _content.asCollection.removeElement(index);
+      _content.asCollection.removeElement(index, pool);
   }
 
   template <typename TAdaptedString>
-  void remove(TAdaptedString key) {
+  void remove(TAdaptedString key, MemoryPool *pool) {
     if (isObject())
-      _content.asCollection.removeMember(key);
+      _content.asCollection.removeMember(key, pool);
   }
 
   void setBoolean(bool value) {
@@ -180,8 +180,7 @@ class VariantData {
   void setLinkedRaw(SerializedValue<const char *> value) {
     if (value.data()) {
       setType(VALUE_IS_LINKED_RAW);
-      _content.asString.data = value.data();
-      _content.asString.size = value.size();
+      setStringPointer(value.data(), value.size());
     } else {
       setType(VALUE_IS_NULL);
     }
@@ -189,16 +188,21 @@ class VariantData {
 
   template <typename T>
   bool storeOwnedRaw(SerializedValue<T> value, MemoryPool *pool) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    const char *replaced = ownedString();
+    size_t replacedSize = _content.asString.size;
+#endif
     const char *dup = pool->saveString(adaptString(value.data(), value.size()));
     if (dup) {
       setType(VALUE_IS_OWNED_RAW);
-      _content.asString.data = dup;
-      _content.asString.size = value.size();
-      return true;
+      setStringPointer(dup, value.size());
     } else {
       setType(VALUE_IS_NULL);
-      return false;
     }
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    releaseReplacedString(replaced, replacedSize, pool);
+#endif
+    return dup != 0;
   }
 
   template <typename T>
@@ -223,8 +227,7 @@ class VariantData {
       setType(VALUE_IS_LINKED_STRING);
     else
       setType(VALUE_IS_OWNED_STRING);
-    _content.asString.data = s.c_str();
-    _content.asString.size = s.size();
+    setStringPointer(s.c_str(), s.size());
   }
 
   CollectionData &toArray() {
@@ -297,11 +300,55 @@ class VariantData {
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
     if (_flags & OWNED_VALUE_BIT)
-      _content.asString.data += stringDistance;
+      _content.asString.data.move(stringDistance, variantDistance);
     if (_flags & COLLECTION_MASK)
       _content.asCollection.movePointers(stringDistance, variantDistance);
   }
 
+  size_t markSlots(const MemoryPool *pool) {
+    if (_flags & COLLECTION_MASK)
+      return _content.asCollection.markSlots(pool);
+    return 0;
+  }
+
+  void forwardSlots(const MovedSlots &moved) {
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.forwardSlots(moved);
+  }
+
+  // Replaces the owned strings with the result of `f(string, length)`
+  template <typename TFunc>
+  void relocateStrings(TFunc &f, const MemoryPool *pool) {
+    if (_flags & OWNED_VALUE_BIT)
+      _content.asString.data.set(
+          f(_content.asString.data.get(), _content.asString.size));
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.relocateStrings(f, pool);
+  }
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // Gives the owned string or the slots back to the pool
+  void release(MemoryPool *pool) {
+    if (_flags & OWNED_VALUE_BIT)
+      pool->freeString(_content.asString.data.get(),
+                       _content.asString.size + 1);
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.release(pool);
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  void rebuildIndexes(MemoryPool *pool) {
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.rebuildIndexes(pool, isObject());
+  }
+
+  void completeIndexes(MemoryPool *pool) {
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.completeIndexes(pool, isObject());
+  }
+#endif
+
   uint8_t type() const {
     return _flags & VALUE_MASK;
   }
@@ -309,12 +356,19 @@ class VariantData {
   template <typename TAdaptedString, typename TStoragePolicy>
   inline bool storeString(TAdaptedString value, MemoryPool *pool,
                           TStoragePolicy storage) {
-    if (value.isNull()) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    const char *replaced = ownedString();
+    size_t replacedSize = _content.asString.size;
+#endif
+    bool ok = true;
+    if (value.isNull())
       setNull();
-      return true;
-    }
-
-    return storage.store(value, pool, VariantStringSetter(this));
+    else
+      ok = storage.store(value, pool, VariantStringSetter(this));
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    releaseReplacedString(replaced, replacedSize, pool);
+#endif
+    return ok;
   }
 
  private:
@@ -323,6 +377,29 @@ class VariantData {
     _flags |= t;
   }
 
+  void setStringPointer(const char *s, size_t n) {
+    _content.asString.data.set(s);
+    _content.asString.size = StringSize(n);
+  }
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  const char *ownedString() const {
+    return _flags & OWNED_VALUE_BIT ? _content.asString.data.get() : 0;
+  }
+
+  // Gives back the owned string that the variant contained, unless the new
+  // value points to the same string
+  void releaseReplacedString(const char *s, size_t n, MemoryPool *pool) {
+    if (!s)
+      return;
+    uint8_t t = type();
+    if (t >= VALUE_IS_LINKED_RAW && t <= VALUE_IS_OWNED_STRING &&
+        _content.asString.data.get() == s)
+      return;
+    pool->freeString(s, n + 1);
+  }
+#endif
+
   struct VariantStringSetter {
     VariantStringSetter(VariantData *instance) : _instance(instance) {}
 
@@ -26,7 +26,7 @@ inline T VariantData::asIntegral() const {
       return convertNumber<T>(_content.asSignedInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
-      return parseNumber<T>(_content.asString.data);
+      return parseNumber<T>(_content.asString.data.get());
     case VALUE_IS_FLOAT:
       return convertNumber<T>(_content.asFloat);
     default:
@@ -62,7 +62,7 @@ inline T VariantData::asFloat() const {
       return static_cast<T>(_content.asSignedInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
-      return parseNumber<T>(_content.asString.data);
+      return parseNumber<T>(_content.asString.data.get());
     case VALUE_IS_FLOAT:
       return static_cast<T>(_content.asFloat);
     default:
@@ -73,10 +73,10 @@ inline T VariantData::asFloat() const {
 inline String VariantData::asString() const {
   switch (type()) {
     case VALUE_IS_LINKED_STRING:
-      return String(_content.asString.data, _content.asString.size,
+      return String(_content.asString.data.get(), _content.asString.size,
                     String::Linked);
     case VALUE_IS_OWNED_STRING:
-      return String(_content.asString.data, _content.asString.size,
+      return String(_content.asString.data.get(), _content.asString.size,
                     String::Copied);
     default:
       return String();
@@ -96,7 +96,8 @@ inline bool VariantData::copyFrom(const VariantData &src, MemoryPool *pool) {
     }
     case VALUE_IS_OWNED_RAW:
       return storeOwnedRaw(
-          serialized(src._content.asString.data, src._content.asString.size),
+          serialized(src._content.asString.data.get(),
+                     src._content.asString.size),
           pool);
     default:
       setType(src.type());
@@ -165,11 +165,13 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE VariantRef() : base_type(0), _pool(0) {}
 
   FORCE_INLINE void clear() const {
+    ARDUINOJSON_ASSERT(!_pool || !_pool->frozen());
     return variantSetNull(_data);
   }
 
   template <typename T>
   FORCE_INLINE bool set(const T &value) const {
+    ARDUINOJSON_ASSERT(!_pool || !_pool->frozen());
     Converter<T>::toJson(value, *this);
     return _pool && !_pool->overflowed();
   }
@@ -180,6 +182,7 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   template <typename T>
   FORCE_INLINE bool set(T *value) const {
+    ARDUINOJSON_ASSERT(!_pool || !_pool->frozen());
     Converter<T *>::toJson(value, *this);
     return _pool && !_pool->overflowed();
   }
@@ -262,7 +265,7 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   FORCE_INLINE void remove(size_t index) const {
     if (_data)
-      _data->remove(index);
+      _data->remove(index, _pool);
   }
   // remove(char*) const
   // remove(const char*) const
@@ -271,7 +274,7 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE typename enable_if<IsString<TChar *>::value>::type remove(
       TChar *key) const {
     if (_data)
-      _data->remove(adaptString(key));
+      _data->remove(adaptString(key), _pool);
   }
   // remove(const std::string&) const
   // remove(const String&) const
@@ -279,17 +282,23 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString &key) const {
     if (_data)
-      _data->remove(adaptString(key));
+      _data->remove(adaptString(key), _pool);
   }
 
   inline void shallowCopy(VariantConstRef target) {
     if (!_data)
       return;
     const VariantData *targetData = VariantAttorney::getData(target);
-    if (targetData)
-      *_data = *targetData;
-    else
+    if (!targetData)
       _data->setNull();
+#if ARDUINOJSON_COMPACT_SLOTS
+    // A CompactPointer can't point to another pool, so we copy the value
+    else
+      _data->copyFrom(*targetData, _pool);
+#else
+    else
+      *_data = *targetData;
+#endif
   }
 
   MemoryPool *getPool() const {
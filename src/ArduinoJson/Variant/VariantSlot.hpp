@@ -4,14 +4,40 @@
 
 #pragma once
 
+#include <ArduinoJson/Memory/CompactPointer.hpp>
 #include <ArduinoJson/Polyfills/integer.hpp>
 #include <ArduinoJson/Polyfills/limits.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
+#if ARDUINOJSON_COMPACT_SLOTS
+typedef int32_t VariantSlotDiff;  // but only 24 bits are stored
+#else
 typedef int_t<ARDUINOJSON_SLOT_OFFSET_SIZE * 8>::type VariantSlotDiff;
+#endif
+
+class MemoryPool;
+class VariantSlot;
+
+// The slots that MemoryPool::compact() moved; each one now contains its new
+// address
+struct MovedSlots {
+  const char* begin;
+  const char* end;
+
+  VariantSlot* forward(VariantSlot* slot) const {
+    const char* p = reinterpret_cast<const char*>(slot);
+    if (p < begin || p >= end)
+      return slot;
+    VariantSlot* newAddress;
+    memcpy(&newAddress, p, sizeof(newAddress));
+    return newAddress;
+  }
+};
 
 class VariantSlot {
   // CAUTION: same layout as VariantData
@@ -19,8 +45,12 @@ class VariantSlot {
   // (+20% on ESP8266 for example)
   VariantContent _content;
   uint8_t _flags;
+#if ARDUINOJSON_COMPACT_SLOTS
+  uint8_t _next[3];  // little-endian, to fill the padding after _flags
+#else
   VariantSlotDiff _next;
-  const char* _key;
+#endif
+  CompactPointer<const char> _key;
 
  public:
   // Must be a POD!
@@ -38,7 +68,8 @@ class VariantSlot {
   }
 
   VariantSlot* next() {
-    return _next ? this + _next : 0;
+    VariantSlotDiff distance = nextDistance();
+    return distance ? this + distance : 0;
   }
 
   const VariantSlot* next() const {
@@ -48,9 +79,10 @@ class VariantSlot {
   VariantSlot* next(size_t distance) {
     VariantSlot* slot = this;
     while (distance--) {
-      if (!slot->_next)
+      VariantSlotDiff next = slot->nextDistance();
+      if (!next)
         return 0;
-      slot += slot->_next;
+      slot += next;
     }
     return slot;
   }
@@ -64,7 +96,7 @@ class VariantSlot {
                                     numeric_limits<VariantSlotDiff>::lowest());
     ARDUINOJSON_ASSERT(!slot || slot - this <=
                                     numeric_limits<VariantSlotDiff>::highest());
-    _next = VariantSlotDiff(slot ? slot - this : 0);
+    setNextDistance(VariantSlotDiff(slot ? slot - this : 0));
   }
 
   void setNextNotNull(VariantSlot* slot) {
@@ -73,7 +105,7 @@ class VariantSlot {
                        numeric_limits<VariantSlotDiff>::lowest());
     ARDUINOJSON_ASSERT(slot - this <=
                        numeric_limits<VariantSlotDiff>::highest());
-    _next = VariantSlotDiff(slot - this);
+    setNextDistance(VariantSlotDiff(slot - this));
   }
 
   void setKey(String k) {
@@ -82,11 +114,11 @@ class VariantSlot {
       _flags &= VALUE_MASK;
     else
       _flags |= OWNED_KEY_BIT;
-    _key = k.c_str();
+    _key.set(k.c_str());
   }
 
   const char* key() const {
-    return _key;
+    return _key.get();
   }
 
   bool ownsKey() const {
@@ -94,19 +126,85 @@ class VariantSlot {
   }
 
   void clear() {
-    _next = 0;
+    setNextDistance(0);
     _flags = 0;
-    _key = 0;
+    _key.set(0);
   }
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
     if (_flags & OWNED_KEY_BIT)
-      _key += stringDistance;
+      _key.move(stringDistance, variantDistance);
     if (_flags & OWNED_VALUE_BIT)
-      _content.asString.data += stringDistance;
+      _content.asString.data.move(stringDistance, variantDistance);
     if (_flags & COLLECTION_MASK)
       _content.asCollection.movePointers(stringDistance, variantDistance);
   }
+
+  bool isMarked() const {
+    return (_flags & SLOT_MARK_BIT) != 0;
+  }
+
+  void mark() {
+    _flags |= SLOT_MARK_BIT;
+  }
+
+  void unmark() {
+    _flags &= static_cast<uint8_t>(~SLOT_MARK_BIT);
+  }
+
+  // Fixes the pointers of a slot that moved by `distance` bytes, while its
+  // targets didn't
+  void relocate(ptrdiff_t distance) {
+    if (_flags & OWNED_KEY_BIT)
+      _key.move(0, distance);
+    if (_flags & OWNED_VALUE_BIT)
+      _content.asString.data.move(0, distance);
+    if (_flags & COLLECTION_MASK)
+      _content.asCollection.relocate(distance);
+  }
+
+  // Fixes the link of a slot that MemoryPool::compact() may have moved from
+  // `oldAddress`, and returns the old address of the next slot
+  VariantSlot* forwardNext(VariantSlot* oldAddress, const MovedSlots& moved) {
+    VariantSlotDiff distance = nextDistance();
+    if (!distance)
+      return 0;
+    VariantSlot* oldNext = oldAddress + distance;
+    setNextNotNull(moved.forward(oldNext));
+    return oldNext;
+  }
+
+  // Replaces the owned strings with the result of `f(string, length)`
+  template <typename TFunc>
+  void relocateStrings(TFunc& f, const MemoryPool* pool);
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // Gives the strings and the children back to the pool
+  void release(MemoryPool* pool);
+#endif
+
+ private:
+#if ARDUINOJSON_COMPACT_SLOTS
+  VariantSlotDiff nextDistance() const {
+    int32_t n = int32_t(_next[0] | _next[1] << 8 | _next[2] << 16);
+    return n & 0x800000 ? n - 0x1000000 : n;
+  }
+
+  void setNextDistance(VariantSlotDiff n) {
+    ARDUINOJSON_ASSERT(n >= -0x800000 && n < 0x800000);
+    _next[0] = uint8_t(n);
+    _next[1] = uint8_t(n >> 8);
+    _next[2] = uint8_t(n >> 16);
+  }
+#else
+  VariantSlotDiff nextDistance() const {
+    return _next;
+  }
+
+  void setNextDistance(VariantSlotDiff n) {
+    _next = n;
+  }
+#endif
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE